@@ -0,0 +1,152 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "chunk.hpp"
+#include "chunk_codec.hpp"
+#include "proc_gen.hpp"
+
+/*
+ * Throughput of the snapshot codec on generated terrain.
+ *
+ * ChunkCodec::encode and decode are timed on their own, in bytes of raw voxel
+ * IDs per second, then whole snapshot records through ChunkSaveData::serialize
+ * and Chunk::deserialize. Every decoded chunk is compared with its voxels.
+ *
+ * Run it from the bin directory, the block registry reads its definitions
+ * from resources.
+*/
+
+using namespace chisel::ChunkDataConstants;
+using chisel::EngineConstants::HEIGHT_MAP_REGION_SIZE;
+
+using VoxelIDs = std::array<chisel::types::VoxelID, CHUNK_VOLUME>;
+
+// Chunk layers from just below the ground up to the highest point of the height spline
+constexpr int BOTTOM_CHUNK_Y = -1;
+constexpr int TOP_CHUNK_Y = 3;
+constexpr unsigned NUM_ROUNDS = 10;
+
+double getSeconds(const std::chrono::steady_clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+// Runs go column by column from bottom to top, voxel y of column c being at c + y * CHUNK_AREA
+bool isDecodedAs(const std::vector<chisel::VoxelRun>& runs, const VoxelIDs& voxel_ids) {
+    size_t position = 0;
+
+    for (const chisel::VoxelRun& run : runs) {
+        for (uint32_t i = 0; i < run.length; i++, position++) {
+            const size_t INDEX = position / CHUNK_HEIGHT + (position % CHUNK_HEIGHT) * CHUNK_AREA;
+            if (position >= CHUNK_VOLUME or voxel_ids[INDEX] != run.voxel_id) return false;
+        }
+    }
+
+    return CHUNK_VOLUME == position;
+}
+
+int main() {
+    TerrainNoise terrain_noise { chisel::EngineConstants::WORLD_SEED };
+    std::vector<float> heights {};
+    terrain_noise.getHeightMapRegion(heights, ChunkPosition { 0, 0, 0 }, HEIGHT_MAP_REGION_SIZE);
+
+    std::vector<ChunkSaveData> saves {};
+    std::vector<VoxelIDs> chunk_voxel_ids {};
+    HeightMap height_map {};
+
+    for (unsigned z = 0; z < HEIGHT_MAP_REGION_SIZE; z++) {
+        for (unsigned x = 0; x < HEIGHT_MAP_REGION_SIZE; x++) {
+            TerrainNoise::sliceHeightMap(heights, HEIGHT_MAP_REGION_SIZE, x, z, height_map);
+
+            for (int y = BOTTOM_CHUNK_Y; y <= TOP_CHUNK_Y; y++) {
+                Chunk chunk { ChunkPosition { static_cast<int>(x), y, static_cast<int>(z) } };
+                chunk.buildDensityVoxels(height_map, terrain_noise);
+                chunk.setPersistence(ChunkPersistence::Snapshot);
+
+                ChunkSaveData& save_data = saves.emplace_back(chunk.getSaveData());
+                VoxelIDs& voxel_ids = chunk_voxel_ids.emplace_back();
+
+                for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+                    save_data.sections[section].copyTo(voxel_ids.data() + section * SECTION_VOLUME);
+                }
+            }
+        }
+    }
+
+    const size_t NUM_CHUNKS = saves.size();
+    std::vector<std::vector<uint8_t>> encodings(NUM_CHUNKS);
+    std::vector<chisel::VoxelRun> runs {};
+    size_t num_mismatches = 0;
+
+    auto encode_elapsed = std::chrono::steady_clock::duration::zero();
+    auto decode_elapsed = std::chrono::steady_clock::duration::zero();
+
+    for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+        for (size_t i = 0; i < NUM_CHUNKS; i++) {
+            encodings[i].clear();
+            chisel::ByteWriter writer { encodings[i] };
+
+            const auto ENCODE_START = std::chrono::steady_clock::now();
+            chisel::ChunkCodec::encode(chunk_voxel_ids[i].data(), writer);
+            encode_elapsed += std::chrono::steady_clock::now() - ENCODE_START;
+
+            chisel::ByteReader reader { encodings[i].data(), encodings[i].size() };
+
+            const auto DECODE_START = std::chrono::steady_clock::now();
+            const bool IS_DECODED = chisel::ChunkCodec::decode(reader, runs);
+            decode_elapsed += std::chrono::steady_clock::now() - DECODE_START;
+
+            if (0 == round and not (IS_DECODED and isDecodedAs(runs, chunk_voxel_ids[i]))) num_mismatches++;
+        }
+    }
+
+    size_t encoded_size = 0;
+    for (const auto& encoding : encodings) encoded_size += encoding.size();
+
+    std::vector<std::vector<uint8_t>> records(NUM_CHUNKS);
+    Chunk chunk {};
+
+    auto serialize_elapsed = std::chrono::steady_clock::duration::zero();
+    auto deserialize_elapsed = std::chrono::steady_clock::duration::zero();
+
+    for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+        for (size_t i = 0; i < NUM_CHUNKS; i++) {
+            records[i].clear();
+
+            const auto SERIALIZE_START = std::chrono::steady_clock::now();
+            saves[i].serialize(records[i]);
+            serialize_elapsed += std::chrono::steady_clock::now() - SERIALIZE_START;
+
+            const auto DESERIALIZE_START = std::chrono::steady_clock::now();
+            const bool IS_LOADED = chunk.deserialize(records[i].data(), records[i].size());
+            deserialize_elapsed += std::chrono::steady_clock::now() - DESERIALIZE_START;
+
+            if (0 == round) {
+                const ChunkSaveData LOADED = chunk.getSaveData();
+                VoxelIDs loaded_ids {};
+
+                for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+                    LOADED.sections[section].copyTo(loaded_ids.data() + section * SECTION_VOLUME);
+                }
+
+                if (not IS_LOADED or loaded_ids != chunk_voxel_ids[i]) num_mismatches++;
+            }
+
+            chunk.resetVoxels();
+        }
+    }
+
+    const double NUM_CODED = static_cast<double>(NUM_CHUNKS * NUM_ROUNDS);
+    const double RAW_BYTES = NUM_CODED * CHUNK_VOLUME * sizeof(chisel::types::VoxelID);
+
+    std::printf("%zu density chunks at y %d to %d, %u rounds\n", NUM_CHUNKS, BOTTOM_CHUNK_Y, TOP_CHUNK_Y, NUM_ROUNDS);
+    std::printf("Encoding:    %8.0f bytes per chunk from %zu raw\n", static_cast<double>(encoded_size) / static_cast<double>(NUM_CHUNKS), CHUNK_VOLUME * sizeof(chisel::types::VoxelID));
+    std::printf("Encode:      %8.2f GB/s, %6.1f us per chunk\n", RAW_BYTES / getSeconds(encode_elapsed) / 1e9, getSeconds(encode_elapsed) * 1e6 / NUM_CODED);
+    std::printf("Decode:      %8.2f GB/s, %6.1f us per chunk\n", RAW_BYTES / getSeconds(decode_elapsed) / 1e9, getSeconds(decode_elapsed) * 1e6 / NUM_CODED);
+    std::printf("Serialize:   %8.1f us per chunk\n", getSeconds(serialize_elapsed) * 1e6 / NUM_CODED);
+    std::printf("Deserialize: %8.1f us per chunk\n", getSeconds(deserialize_elapsed) * 1e6 / NUM_CODED);
+    std::printf("Mismatches:  %8zu\n", num_mismatches);
+
+    return 0 == num_mismatches ? 0 : 1;
+}
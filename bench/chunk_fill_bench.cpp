@@ -0,0 +1,178 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "chunk.hpp"
+#include "proc_gen.hpp"
+
+/*
+ * Chunks per second of heightmap terrain generation.
+ *
+ * Chunk::buildVoxels, which fills each section a whole layer at a time, is
+ * compared with the fill it replaced: the loop of the original buildVoxels
+ * over its flat array of voxel IDs, kept here as BaselineChunk. Heightmaps are
+ * generated up front so only the voxel filling is timed, and both fills are
+ * checked to produce the same voxels.
+ *
+ * Run it from the bin directory, the block registry reads its definitions
+ * from resources.
+*/
+
+using namespace chisel::ChunkDataConstants;
+
+// Chunk layers from just below the ground up to the highest point of the height spline
+constexpr int BOTTOM_CHUNK_Y = -1;
+constexpr int TOP_CHUNK_Y = 3;
+constexpr unsigned NUM_ROUNDS = 10;
+
+// Height spline of the terrain, defined in chunk.cpp
+unsigned getHeight(float noise);
+
+/*
+ * The original fill, unchanged but for cubic chunks: columns are walked
+ * from the bottom of the chunk, and world y decides the stratum where the
+ * original chunks started at y 0.
+*/
+class BaselineChunk {
+    ChunkPosition position {};
+    std::array<chisel::types::VoxelID, CHUNK_VOLUME> voxel_ids {};
+
+    [[nodiscard]] static VoxelIndex toIndex(const LocalPosition local) {
+        return local.x + CHUNK_SIZE * local.z + CHUNK_AREA * local.y;
+    }
+public:
+    explicit BaselineChunk(const ChunkPosition position) : position(position) {}
+
+    void buildVoxels(const HeightMap& height_map) {
+        const auto& block_registry = chisel::BlockRegistry::getInstance();
+
+        [[maybe_unused]] chisel::types::VoxelID water_id = block_registry.getVoxelID("chisel::water");
+        chisel::types::VoxelID stone_id = block_registry.getVoxelID("chisel::stone");
+        chisel::types::VoxelID dirt_id = block_registry.getVoxelID("chisel::dirt");
+        chisel::types::VoxelID grass_block_id = block_registry.getVoxelID("chisel::grass_block");
+        chisel::types::VoxelID sand_id = block_registry.getVoxelID("chisel::sand");
+
+        std::random_device dev;
+        std::mt19937 rng(dev());
+        [[maybe_unused]] std::uniform_int_distribution<std::mt19937::result_type> dist6(1,6);
+
+        const int CHUNK_BOTTOM = position.y * static_cast<int>(CHUNK_HEIGHT);
+
+        for (unsigned x = 0; x < CHUNK_SIZE; x++) {
+            for (unsigned z = 0; z < CHUNK_SIZE; z++) {
+                glm::vec3 voxel_position = Conversion::toWorld(LocalPosition(x, 0, z), position);
+                voxel_position /= static_cast<float>(CHUNK_SIZE);
+
+                const auto y_level = static_cast<int>(getHeight(height_map.at(z * CHUNK_SIZE + x)));
+
+                chisel::types::VoxelID id {};
+                for (unsigned local_y = 0; local_y < CHUNK_HEIGHT and CHUNK_BOTTOM + static_cast<int>(local_y) < y_level; local_y++) {
+                    const int y = CHUNK_BOTTOM + static_cast<int>(local_y);
+
+                    if (y <= 8) {
+                        id = stone_id;
+                    } else if (8 < y and y <= 11) {
+                        id = sand_id;
+                    } else if (11 < y and y <= 16) {
+                        id = dirt_id;
+                    } else if (16 < y and y <= 36) {
+                        id = grass_block_id;
+                    } else {
+                        id = stone_id;
+                    }
+
+                    setVoxelIDAtPosition(id, { x, local_y, z });
+                }
+            }
+        }
+    }
+
+    void resetVoxels() {
+        std::fill(std::begin(voxel_ids), std::end(voxel_ids), chisel::AIR_ID);
+    }
+
+    void setVoxelIDAtPosition(const chisel::types::VoxelID voxel_id, const LocalPosition local) {
+        try {
+            voxel_ids.at(toIndex(local)) = voxel_id;
+        } catch (std::out_of_range& e) {
+            std::cerr << local.x << ' ' << local.y << ' ' << local.z << '\n';
+            std::cerr << e.what() << '\n';
+        }
+    }
+
+    [[nodiscard]] chisel::types::VoxelID getVoxelID(const LocalPosition local) const {
+        return voxel_ids.at(toIndex(local));
+    }
+};
+
+struct BenchChunk {
+    ChunkPosition position {};
+    HeightMap height_map {};
+};
+
+double getChunksPerSecond(const size_t num_chunks, const std::chrono::steady_clock::duration elapsed) {
+    return static_cast<double>(num_chunks) / std::chrono::duration<double>(elapsed).count();
+}
+
+int main() {
+    using chisel::EngineConstants::HEIGHT_MAP_REGION_SIZE;
+
+    TerrainNoise terrain_noise { chisel::EngineConstants::WORLD_SEED };
+    std::vector<float> heights {};
+    terrain_noise.getHeightMapRegion(heights, ChunkPosition { 0, 0, 0 }, HEIGHT_MAP_REGION_SIZE);
+
+    std::vector<BenchChunk> bench_chunks {};
+
+    for (unsigned z = 0; z < HEIGHT_MAP_REGION_SIZE; z++) {
+        for (unsigned x = 0; x < HEIGHT_MAP_REGION_SIZE; x++) {
+            for (int y = BOTTOM_CHUNK_Y; y <= TOP_CHUNK_Y; y++) {
+                BenchChunk& bench_chunk = bench_chunks.emplace_back();
+                bench_chunk.position = { static_cast<int>(x), y, static_cast<int>(z) };
+                TerrainNoise::sliceHeightMap(heights, HEIGHT_MAP_REGION_SIZE, x, z, bench_chunk.height_map);
+            }
+        }
+    }
+
+    auto build_elapsed = std::chrono::steady_clock::duration::zero();
+    auto baseline_elapsed = std::chrono::steady_clock::duration::zero();
+    size_t num_mismatches = 0;
+
+    Chunk chunk {};
+
+    for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+        for (const BenchChunk& bench_chunk : bench_chunks) {
+            chunk.setPosition(bench_chunk.position);
+            BaselineChunk baseline_chunk { bench_chunk.position };
+
+            const auto BUILD_START = std::chrono::steady_clock::now();
+            chunk.buildVoxels(bench_chunk.height_map);
+            build_elapsed += std::chrono::steady_clock::now() - BUILD_START;
+
+            const auto BASELINE_START = std::chrono::steady_clock::now();
+            baseline_chunk.buildVoxels(bench_chunk.height_map);
+            baseline_elapsed += std::chrono::steady_clock::now() - BASELINE_START;
+
+            if (0 == round) {
+                for (unsigned index = 0; index < CHUNK_VOLUME; index++) {
+                    const LocalPosition LOCAL { index % CHUNK_SIZE, index / CHUNK_AREA, index / CHUNK_SIZE % CHUNK_SIZE };
+                    if (chunk.getVoxelID(LOCAL) != baseline_chunk.getVoxelID(LOCAL)) num_mismatches++;
+                }
+            }
+
+            chunk.resetVoxels();
+        }
+    }
+
+    const size_t NUM_CHUNKS = bench_chunks.size() * NUM_ROUNDS;
+    const double BUILD_RATE = getChunksPerSecond(NUM_CHUNKS, build_elapsed);
+    const double BASELINE_RATE = getChunksPerSecond(NUM_CHUNKS, baseline_elapsed);
+
+    std::printf("%zu chunks at y %d to %d\n", NUM_CHUNKS, BOTTOM_CHUNK_Y, TOP_CHUNK_Y);
+    std::printf("Baseline fill: %10.0f chunks/s\n", BASELINE_RATE);
+    std::printf("buildVoxels:   %10.0f chunks/s (%.1fx)\n", BUILD_RATE, BUILD_RATE / BASELINE_RATE);
+    std::printf("Mismatches:    %10zu\n", num_mismatches);
+
+    return 0 == num_mismatches ? 0 : 1;
+}
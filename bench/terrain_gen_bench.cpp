@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "chunk.hpp"
+#include "proc_gen.hpp"
+
+/*
+ * Chunks per second of the two terrain generators, noise included.
+ *
+ * Both start from the same heightmap regions, generated in one grid per
+ * HEIGHT_MAP_REGION_SIZE x HEIGHT_MAP_REGION_SIZE chunk columns as the height
+ * map cache does. The heightmap path then fills chunks with buildVoxels, the
+ * density path samples 3D noise with getDensityGrid through buildDensityVoxels.
+ *
+ * Run it from the bin directory, the block registry reads its definitions
+ * from resources.
+*/
+
+using namespace chisel::ChunkDataConstants;
+using chisel::EngineConstants::HEIGHT_MAP_REGION_SIZE;
+
+// Chunk layers from just below the ground up to the highest point of the height spline
+constexpr int BOTTOM_CHUNK_Y = -1;
+constexpr int TOP_CHUNK_Y = 3;
+constexpr int NUM_REGIONS = 4;
+constexpr unsigned NUM_ROUNDS = 3;
+
+double getChunksPerSecond(const size_t num_chunks, const std::chrono::steady_clock::duration elapsed) {
+    return static_cast<double>(num_chunks) / std::chrono::duration<double>(elapsed).count();
+}
+
+int main() {
+    TerrainNoise terrain_noise { chisel::EngineConstants::WORLD_SEED };
+    std::vector<float> heights {};
+    HeightMap height_map {};
+    Chunk chunk {};
+
+    auto height_map_elapsed = std::chrono::steady_clock::duration::zero();
+    auto build_elapsed = std::chrono::steady_clock::duration::zero();
+    auto density_elapsed = std::chrono::steady_clock::duration::zero();
+    size_t num_chunks = 0;
+
+    for (unsigned round = 0; round < NUM_ROUNDS; round++) {
+        for (int region = 0; region < NUM_REGIONS; region++) {
+            const ChunkPosition ORIGIN { region * static_cast<int>(HEIGHT_MAP_REGION_SIZE), 0, 0 };
+
+            const auto HEIGHT_MAP_START = std::chrono::steady_clock::now();
+            terrain_noise.getHeightMapRegion(heights, ORIGIN, HEIGHT_MAP_REGION_SIZE);
+            height_map_elapsed += std::chrono::steady_clock::now() - HEIGHT_MAP_START;
+
+            for (unsigned z = 0; z < HEIGHT_MAP_REGION_SIZE; z++) {
+                for (unsigned x = 0; x < HEIGHT_MAP_REGION_SIZE; x++) {
+                    TerrainNoise::sliceHeightMap(heights, HEIGHT_MAP_REGION_SIZE, x, z, height_map);
+
+                    for (int y = BOTTOM_CHUNK_Y; y <= TOP_CHUNK_Y; y++) {
+                        chunk.setPosition({ ORIGIN.x + static_cast<int>(x), y, ORIGIN.z + static_cast<int>(z) });
+
+                        const auto BUILD_START = std::chrono::steady_clock::now();
+                        chunk.buildVoxels(height_map);
+                        build_elapsed += std::chrono::steady_clock::now() - BUILD_START;
+                        chunk.resetVoxels();
+
+                        const auto DENSITY_START = std::chrono::steady_clock::now();
+                        chunk.buildDensityVoxels(height_map, terrain_noise);
+                        density_elapsed += std::chrono::steady_clock::now() - DENSITY_START;
+                        chunk.resetVoxels();
+
+                        num_chunks++;
+                    }
+                }
+            }
+        }
+    }
+
+    // The heightmap regions are needed by both generators, so each pays for them
+    const double HEIGHT_MAP_RATE = getChunksPerSecond(num_chunks, height_map_elapsed + build_elapsed);
+    const double DENSITY_RATE = getChunksPerSecond(num_chunks, height_map_elapsed + density_elapsed);
+
+    std::printf("%zu chunks at y %d to %d\n", num_chunks, BOTTOM_CHUNK_Y, TOP_CHUNK_Y);
+    std::printf("Heightmap regions: %8.1f us per chunk\n", std::chrono::duration<double, std::micro>(height_map_elapsed).count() / static_cast<double>(num_chunks));
+    std::printf("Heightmap path:    %8.0f chunks/s\n", HEIGHT_MAP_RATE);
+    std::printf("Density path:      %8.0f chunks/s (%.2fx the heightmap path)\n", DENSITY_RATE, DENSITY_RATE / HEIGHT_MAP_RATE);
+
+    return 0;
+}
@@ -16,29 +16,60 @@ namespace chisel::EngineConstants {
     constexpr bool IS_DEBUGGING_ENABLED = true;
     constexpr std::string_view ENGINE_BUILD_TYPE = "Debug";
     #endif
-    constexpr unsigned CHUNKS_TO_BUILD_PER_FRAME = 8;
-    constexpr unsigned CHUNKS_TO_REBUILD_PER_FRAME = 8;
+    constexpr unsigned MESH_JOBS_IN_FLIGHT_PER_WORKER = 4;
+    constexpr unsigned TERRAIN_JOBS_IN_FLIGHT_PER_WORKER = 4;
+    // Share of the worker threads given to terrain generation, the rest mesh chunks
+    constexpr float TERRAIN_WORKER_SHARE = 0.5f;
+    constexpr float CHUNK_BUILD_BUDGET_MS = 4.0f;
+    constexpr float CHUNK_STREAM_BUDGET_MS = 2.0f;
+    constexpr unsigned RESERVED_MESH_FACES_PER_WORKER = 8192;
 
-    constexpr unsigned LOAD_DISTANCE = 32;
+    // In chunks, about 480 blocks around and 64 blocks above and below the player
+    constexpr unsigned LOAD_DISTANCE = 15;
+    constexpr unsigned VERTICAL_LOAD_DISTANCE = 2;
+
+    constexpr int WORLD_SEED = 1;
+    constexpr std::string_view WORLD_SAVE_DIRECTORY = "saves/world";
+
+    // Only edited chunks are saved, as their edits over the generated terrain, instead of every chunk visited
+    constexpr bool IS_DELTA_PERSISTENCE_ENABLED = true;
+
+    // 3D density terrain with caves and overhangs instead of the plain heightmap
+    constexpr bool IS_CAVE_GENERATION_ENABLED = true;
+
+    // Heightmaps are generated for 8x8 chunk columns at once
+    constexpr unsigned HEIGHT_MAP_REGION_SHIFT = 3;
+    constexpr unsigned HEIGHT_MAP_REGION_SIZE = 1 << HEIGHT_MAP_REGION_SHIFT;
     constexpr float MAX_RAY_LENGTH = 8.78f;
     constexpr unsigned MAX_VOXEL_TRAVERSED = 8;
     constexpr GLsizei MULTISAMPLE_LEVEL = 3;
 }
 
 namespace chisel::ChunkDataConstants {
-    // WARNING: Vertex x, y, z value range must match CHUNK_SIZE and CHUNK_HEIGHT
-    constexpr unsigned  X_SIZE = 4,
+    // WARNING: Vertex x, y, z value range must match CHUNK_SIZE and CHUNK_HEIGHT.
+    // Chunk dimensions are powers of two, X_SIZE = 4 gives 16 wide chunks and X_SIZE = 5 gives 32
+    constexpr unsigned  X_SIZE = 5,
                         Z_SIZE = X_SIZE,
-                        Y_SIZE = 7,
+                        Y_SIZE = X_SIZE,
                         AO_ID_SIZE = 2,
                         FACE_ID_SIZE = 3,
                         VOXEL_ID_SIZE = 8;
 
-    constexpr unsigned CHUNK_SIZE = (1 << X_SIZE) - 1;
-    constexpr unsigned CHUNK_HEIGHT = (1 << Y_SIZE) - 1;
+    constexpr unsigned CHUNK_SIZE = 1 << X_SIZE;
+    constexpr unsigned CHUNK_HEIGHT = 1 << Y_SIZE;
+    constexpr unsigned CHUNK_SIZE_MASK = CHUNK_SIZE - 1;
+    constexpr unsigned CHUNK_HEIGHT_MASK = CHUNK_HEIGHT - 1;
+
+    constexpr unsigned PADDED_CHUNK_SIZE = CHUNK_SIZE + 2;
 
     constexpr unsigned CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
     constexpr unsigned CHUNK_VOLUME = CHUNK_AREA * CHUNK_HEIGHT;
+
+    // Chunks are stored as a stack of sections of at most 16 layers
+    constexpr unsigned SECTION_HEIGHT = CHUNK_HEIGHT < 16 ? CHUNK_HEIGHT : 16;
+    constexpr unsigned NUM_SECTIONS = CHUNK_HEIGHT / SECTION_HEIGHT;
+    constexpr unsigned SECTION_VOLUME = CHUNK_AREA * SECTION_HEIGHT;
+    static_assert(CHUNK_HEIGHT % SECTION_HEIGHT == 0, "Sections must tile the chunk height");
 }
 
 #endif
@@ -16,71 +16,12 @@
 #include "block_textures.hpp"
 #include "camera.hpp"
 #include "ray_casting.hpp"
+#include "chunk_streamer.hpp"
 #include "framebuffer.hpp"
 #include "ray_casting.hpp"
+#include "quad_index_buffer.hpp"
 #include "ubo_view_projection.hpp"
 
-void loadWorld(chisel::ChunkPool& pool, const ChunkPosition player_position) {
-    const int X_MIN = -static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.x;
-    const int X_MAX =  static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.x;
-    const int Z_MIN = -static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.z;
-    const int Z_MAX =  static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.z;
-
-    const ChunkPosition CORNER_1 { X_MIN, 0, Z_MIN };
-    const ChunkPosition CORNER_2 { X_MAX, 0, Z_MIN };
-    const ChunkPosition CORNER_3 { X_MIN, 0, Z_MAX };
-    const ChunkPosition CORNER_4 { X_MAX, 0, Z_MAX };
-    const ChunkPosition CENTER   { player_position.x, 0, player_position.z };
-
-    const std::array starting_points = { CORNER_1, CORNER_2, CORNER_3, CORNER_4, CENTER };
-    constexpr std::array directions = { Direction::North, Direction::South, Direction::East, Direction::West };
-
-    std::queue<ChunkPosition> build_queue {};
-
-    for (auto const &point : starting_points) {
-        if (pool.isPositionUsed(point)) continue;
-        pool.use(point);
-        pool.enqueueForBuilding(point);
-        build_queue.push(point);
-    }
-
-    while (not build_queue.empty()) {
-        ChunkPosition position = build_queue.front();
-        build_queue.pop();
-
-        for (auto const &direction : directions) {
-            const ChunkPosition neighbor = position + CHUNK_NEIGHBORS_DIRECTION.at(direction);
-            if (pool.isPositionUsed(neighbor)) {
-                if (not pool.isBuilt(neighbor)) continue;
-                pool.enqueueForRebuilding(neighbor);
-                continue;
-            }
-
-            if (X_MIN > neighbor.x || neighbor.x > X_MAX || Z_MIN > neighbor.z || neighbor.z > Z_MAX) continue;
-
-            build_queue.push(neighbor);
-            pool.use(neighbor);
-            pool.enqueueForBuilding(neighbor);
-        }
-    }
-}
-
-void removeChunks(chisel::ChunkPool& pool, const ChunkPosition player_position) {
-    const int X_MIN = -static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.x;
-    const int X_MAX =  static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.x;
-    const int Z_MIN = -static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.z;
-    const int Z_MAX =  static_cast<int>(chisel::EngineConstants::LOAD_DISTANCE) + player_position.z;
-
-    const auto& used_chunks = pool.getUsedChunks();
-
-    for (const auto &position : used_chunks) {
-        if (X_MIN <= position.x && position.x <= X_MAX &&
-                Z_MIN <= position.z && position.z <= Z_MAX) continue;
-
-        pool.recycle(position);
-    }
-}
-
 ShaderID initializeChunkVertexShader() {
     std::ostringstream INJECTED_VERTEX_CODE;
     INJECTED_VERTEX_CODE << "#version 460 core\n\n";
@@ -94,17 +35,33 @@ ShaderID initializeChunkVertexShader() {
     INJECTED_VERTEX_CODE << "const float shades[6] = float[6](1.0, 0.7, 0.8, 0.6, 0.84, 0.8);\n";
     INJECTED_VERTEX_CODE << "const float ao[4] = float[4](0.7, 0.8, 0.9, 1.0);\n\n";
 
-    INJECTED_VERTEX_CODE << "const int uv_indices[24] = int[24](\n";
-    INJECTED_VERTEX_CODE << "    2, 0, 1, 3, // Top\n";
-    INJECTED_VERTEX_CODE << "    0, 2, 3, 1, // Bottom\n";
-    INJECTED_VERTEX_CODE << "    2, 3, 1, 0, // North\n";
-    INJECTED_VERTEX_CODE << "    0, 1, 3, 2, // South\n";
-    INJECTED_VERTEX_CODE << "    0, 1, 3, 2, // East\n";
-    INJECTED_VERTEX_CODE << "    2, 3, 1, 0  //West\n);\n\n";
-
-    INJECTED_VERTEX_CODE << "const vec2 uv_coords[4] = vec2[4](\n";
-    INJECTED_VERTEX_CODE << "    vec2(0.0f, 0.0f), vec2(0.0f, 1.0f),\n";
-    INJECTED_VERTEX_CODE << "    vec2(1.0f, 0.0f), vec2(1.0f, 1.0f)\n);\n";
+    // Texture axes of each face, UVs are taken from the vertex position so merged quads tile their texture
+    INJECTED_VERTEX_CODE << "const vec3 uv_axes[12] = vec3[12](\n";
+    INJECTED_VERTEX_CODE << "    vec3(-1, 0, 0), vec3(0, 0, 1), // Top\n";
+    INJECTED_VERTEX_CODE << "    vec3( 1, 0, 0), vec3(0, 0, 1), // Bottom\n";
+    INJECTED_VERTEX_CODE << "    vec3( 0, 0,-1), vec3(0, 1, 0), // North\n";
+    INJECTED_VERTEX_CODE << "    vec3( 0, 0, 1), vec3(0, 1, 0), // South\n";
+    INJECTED_VERTEX_CODE << "    vec3( 1, 0, 0), vec3(0, 1, 0), // East\n";
+    INJECTED_VERTEX_CODE << "    vec3(-1, 0, 0), vec3(0, 1, 0)  // West\n);\n\n";
+
+    // Corners of a unit face, scaled by the quad size along each axis
+    INJECTED_VERTEX_CODE << "const vec3 face_corners[24] = vec3[24](\n";
+    INJECTED_VERTEX_CODE << "    vec3(0, 1, 0), vec3(1, 1, 0), vec3(1, 1, 1), vec3(0, 1, 1), // Top\n";
+    INJECTED_VERTEX_CODE << "    vec3(0, 0, 0), vec3(1, 0, 0), vec3(1, 0, 1), vec3(0, 0, 1), // Bottom\n";
+    INJECTED_VERTEX_CODE << "    vec3(1, 0, 0), vec3(1, 1, 0), vec3(1, 1, 1), vec3(1, 0, 1), // North\n";
+    INJECTED_VERTEX_CODE << "    vec3(0, 0, 0), vec3(0, 1, 0), vec3(0, 1, 1), vec3(0, 0, 1), // South\n";
+    INJECTED_VERTEX_CODE << "    vec3(0, 0, 1), vec3(0, 1, 1), vec3(1, 1, 1), vec3(1, 0, 1), // East\n";
+    INJECTED_VERTEX_CODE << "    vec3(0, 0, 0), vec3(0, 1, 0), vec3(1, 1, 0), vec3(1, 0, 0)  // West\n);\n\n";
+
+    // Corner drawn at each slot of the shared { 0, 1, 2, 0, 2, 3 } index pattern, the second half of every
+    // face is rotated by one to split the quad along the other diagonal when AO calls for it
+    INJECTED_VERTEX_CODE << "const uint face_vertex_order[48] = uint[48](\n";
+    INJECTED_VERTEX_CODE << "    0, 3, 2, 1,  1, 0, 3, 2, // Top\n";
+    INJECTED_VERTEX_CODE << "    0, 1, 2, 3,  1, 2, 3, 0, // Bottom\n";
+    INJECTED_VERTEX_CODE << "    0, 1, 2, 3,  1, 2, 3, 0, // North\n";
+    INJECTED_VERTEX_CODE << "    0, 3, 2, 1,  1, 0, 3, 2, // South\n";
+    INJECTED_VERTEX_CODE << "    0, 3, 2, 1,  1, 0, 3, 2, // East\n";
+    INJECTED_VERTEX_CODE << "    0, 1, 2, 3,  1, 2, 3, 0  // West\n);\n\n";
 
     std::string VERTEX_CODE = getFileContent("resources/shaders/chunk.vert");
 
@@ -140,6 +97,7 @@ int main(int argc, char** argv) {
 
     stbi_set_flip_vertically_on_load(true);
     setupUBOViewProjection();
+    setupQuadIndexBuffer();
 
     auto& block_registry = chisel::BlockRegistry::getInstance();
     chisel::BlockTextures block_textures;
@@ -246,16 +204,13 @@ int main(int argc, char** argv) {
     player_camera.setPosition({ 0.0f, 40.0f, 0.0f });
 
     RayCastResult ray_cast_result {};
-    ChunkPosition prev_player_position, current_player_position;
 
     bool is_using_cinematic_camera = false;
     bool is_switching_controls = false;
 
-    prev_player_position = Conversion::toChunk(player_camera.getPosition());
-    current_player_position = Conversion::toChunk(player_camera.getPosition());
-
     chisel::ChunkPool pool {};
-    loadWorld(pool, current_player_position);
+    chisel::ChunkStreamer streamer { pool };
+    streamer.setCenter(Conversion::toChunk(player_camera.getPosition()));
 
     // Game State
     bool enable_break_block = false;
@@ -264,6 +219,8 @@ int main(int argc, char** argv) {
     bool running = true;
     SDL_Event event;
 
+    std::vector<ChunkPosition> used_chunks {};
+
     uint32_t now = SDL_GetTicks();
     uint32_t last = 0;
     float delta_time = 0;
@@ -310,6 +267,8 @@ int main(int argc, char** argv) {
                     is_using_cinematic_camera = !is_using_cinematic_camera;
                 } else if (SDL_SCANCODE_R == event.key.scancode) {
                     is_switching_controls = !is_switching_controls;
+                } else if (SDL_SCANCODE_G == event.key.scancode) {
+                    pool.setMeshingMode(MeshingMode::Greedy == pool.getMeshingMode() ? MeshingMode::Naive : MeshingMode::Greedy);
                 }
 
                 else if (SDL_SCANCODE_1 == event.key.scancode) {
@@ -371,17 +330,13 @@ int main(int argc, char** argv) {
         }
 
         glm::vec3 player_position = player_camera.getPosition();
-        current_player_position = Conversion::toChunk(player_position);
+        streamer.setCenter(Conversion::toChunk(player_position));
+        streamer.processPendingLoads(chisel::EngineConstants::CHUNK_STREAM_BUDGET_MS);
 
-        if (prev_player_position.x != current_player_position.x
-            or prev_player_position.z != current_player_position.z) {
-            removeChunks(pool, current_player_position);
-            loadWorld(pool, current_player_position);
-            prev_player_position = current_player_position;
-        }
+        const auto&& frustum_planes = player_camera.getFrustumPlanes();
+        pool.setViewpoint(player_position, frustum_planes);
 
-        pool.buildQueuedChunks();
-        pool.rebuildQueuedChunks();
+        pool.processQueuedChunks(chisel::EngineConstants::CHUNK_BUILD_BUDGET_MS);
 
         multisample_framebuffer.bind();
         chisel::clearWindow(0.45490f, 0.70196f, 1.0f, 1.0f);
@@ -390,14 +345,15 @@ int main(int argc, char** argv) {
         activateShaderProgram(chunk_shader_program);
         block_textures.bind();
         bindUBOViewProjection();
+        bindQuadIndexBuffer();
 
         if (wireframe) glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-        const auto&& frustum_planes = player_camera.getFrustumPlanes();
-        const auto& used_chunks = pool.getUsedChunks();
+        pool.getUsedChunks(used_chunks);
 
         for (const auto &position : used_chunks) {
             // if (not pool.isVisible(position, frustum_planes)) continue;
+            if (not pool.isBuilt(position)) continue;
             uniformMat4f(chunk_shader_program, "model", 1, GL_FALSE, Conversion::toChunkModel(position));
             pool.renderUsedChunk(position);
         }
@@ -446,6 +402,10 @@ int main(int argc, char** argv) {
         ImGui::Text("Avg. Frame Generation Time - %d frame(s): %.3lf ms", UPDATE_FREQUENCY, average_elapsed_time * 1000.0f);
         ImGui::Text("Coordinates: %f, %f, %f", player_position.x, player_position.y, player_position.z);
         ImGui::Text("Cardinal Direction: %s", player_camera.getCardinalDirection().c_str());
+        ImGui::Text("Mesher: %s", MeshingMode::Greedy == pool.getMeshingMode() ? "Greedy" : "Naive");
+        ImGui::Text("Quads: %zu", pool.getNumBuiltQuads());
+        ImGui::Text("Pending Loads: %zu", streamer.getNumPendingLoads());
+        ImGui::Text("Voxel Memory: %.1f MB", static_cast<double>(pool.getVoxelMemoryUsage()) / (1024.0 * 1024.0));
 
         ImGui::NewLine();
 
@@ -462,6 +422,8 @@ int main(int argc, char** argv) {
         chisel::swapBuffers(p_window);
     }
 
+    pool.saveDirtyChunks();
+
     intermediate_framebuffer.destroy();
     multisample_framebuffer.destroy();
 
@@ -19,8 +19,8 @@ vec4 texture2DArrayAA(sampler2DArray tex, vec2 uv) {
 }
 
 void main() {
-    vec2 face_uv = fs_uv_coords;
-    face_uv.x = (fs_uv_coords.x / 6) + (float(fs_face_id) / 6);
+    vec2 face_uv = fract(fs_uv_coords);
+    face_uv.x = (face_uv.x / 6) + (float(fs_face_id) / 6);
 
     vec3 tex_color = texture2DArrayAA(texture_array, face_uv).rgb;
     vec4 final_color = vec4(vec3(1.0f) * fs_shades, 1.0f);
@@ -1,9 +1,10 @@
-struct VertexData {
-    uint packed_data;
+struct QuadData {
+    uint packed_face;
+    uint packed_shape;
 };
 
-layout(binding = 0, std430) restrict readonly buffer Vertices {
-    VertexData in_vertices[];
+layout(binding = 0, std430) restrict readonly buffer Quads {
+    QuadData in_quads[];
 };
 
 layout(binding = 0, std140) uniform ViewProjection {
@@ -24,27 +25,45 @@ uint popBits(uint base, int size) {
     return base >> size;
 }
 
+// Quad k owns vertex IDs 4k to 4k+3, the low two bits select the slot within the quad
 void unpack(int vertex_id) {
-    uint packed_data = in_vertices[vertex_id].packed_data;
+    uint packed_face  = in_quads[vertex_id >> 2].packed_face;
+    uint packed_shape = in_quads[vertex_id >> 2].packed_shape;
+    uint slot = uint(vertex_id) & 3u;
 
-    voxel_id = bitfieldExtract(packed_data, 0, VOXEL_ID_SIZE);
-    packed_data = popBits(packed_data, VOXEL_ID_SIZE);
+    voxel_id = bitfieldExtract(packed_face, 0, VOXEL_ID_SIZE);
+    packed_face = popBits(packed_face, VOXEL_ID_SIZE);
 
-    face_id  = bitfieldExtract(packed_data, 0, FACE_ID_SIZE);
-    packed_data = popBits(packed_data, FACE_ID_SIZE);
+    face_id  = bitfieldExtract(packed_face, 0, FACE_ID_SIZE);
+    packed_face = popBits(packed_face, FACE_ID_SIZE);
 
-    ao_id    = bitfieldExtract(packed_data, 0, AO_ID_SIZE);
-    packed_data = popBits(packed_data, AO_ID_SIZE);
+    uint z = bitfieldExtract(packed_face, 0, Z_SIZE);
+    packed_face = popBits(packed_face, Z_SIZE);
 
-    uint z = bitfieldExtract(packed_data, 0, Z_SIZE);
-    packed_data = popBits(packed_data, Z_SIZE);
+    uint y = bitfieldExtract(packed_face, 0, Y_SIZE);
+    packed_face = popBits(packed_face, Y_SIZE);
 
-    uint y = bitfieldExtract(packed_data, 0, Y_SIZE);
-    packed_data = popBits(packed_data, Y_SIZE);
+    uint x = bitfieldExtract(packed_face, 0, X_SIZE);
 
-    uint x = bitfieldExtract(packed_data, 0, X_SIZE);
+    uint size_z = bitfieldExtract(packed_shape, 0, Z_SIZE);
+    packed_shape = popBits(packed_shape, Z_SIZE);
 
-    position = vec3(x, y, z);
+    uint size_y = bitfieldExtract(packed_shape, 0, Y_SIZE);
+    packed_shape = popBits(packed_shape, Y_SIZE);
+
+    uint size_x = bitfieldExtract(packed_shape, 0, X_SIZE);
+    packed_shape = popBits(packed_shape, X_SIZE);
+
+    uint corner_ao[4];
+    for (int i = 0; i < 4; i++) {
+        corner_ao[i] = bitfieldExtract(packed_shape, i * AO_ID_SIZE, AO_ID_SIZE);
+    }
+
+    bool is_flipped = corner_ao[0] + corner_ao[2] <= corner_ao[1] + corner_ao[3];
+    uint corner = face_vertex_order[face_id * 8u + (is_flipped ? 4u : 0u) + slot];
+
+    ao_id    = corner_ao[corner];
+    position = vec3(x, y, z) + face_corners[face_id * 4u + corner] * (vec3(size_x, size_y, size_z) + 1.0);
 }
 
 uniform mat4 model;
@@ -61,8 +80,7 @@ void main() {
     fs_face_id  = face_id;
     fs_voxel_id = voxel_id;
 
-    int uv_index = gl_VertexID % 4 + int(face_id) * 4;
-    fs_uv_coords = uv_coords[uv_indices[uv_index]];
+    fs_uv_coords = vec2(dot(position, uv_axes[face_id * 2u]), dot(position, uv_axes[face_id * 2u + 1u]));
     fs_shades =  shades[face_id] * ao[ao_id];
 
     gl_Position = projection * view * model * vec4(position, 1.0f);
@@ -0,0 +1,41 @@
+#include "quad_index_buffer.hpp"
+
+constexpr GLsizei INITIAL_NUM_QUADS = 16384;
+
+GLuint VAO_QuadIndices;
+GLuint EBO_QuadIndices;
+GLsizei quad_index_capacity = 0;
+
+void setupQuadIndexBuffer() {
+    glCreateVertexArrays(1, &VAO_QuadIndices);
+    reserveQuadIndexBuffer(INITIAL_NUM_QUADS);
+}
+
+void reserveQuadIndexBuffer(const GLsizei num_quads) {
+    if (num_quads <= quad_index_capacity) return;
+
+    GLsizei capacity = quad_index_capacity > 0 ? quad_index_capacity : INITIAL_NUM_QUADS;
+    while (capacity < num_quads) capacity *= 2;
+
+    std::vector<GLuint> indices {};
+    indices.reserve(static_cast<std::size_t>(capacity) * 6);
+
+    for (GLuint quad = 0; quad < static_cast<GLuint>(capacity); quad++) {
+        for (const GLuint offset : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+            indices.emplace_back(quad * 4 + offset);
+        }
+    }
+
+    GLuint ebo {};
+    glCreateBuffers(1, &ebo);
+    glNamedBufferStorage(ebo, static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)), indices.data(), 0);
+    glVertexArrayElementBuffer(VAO_QuadIndices, ebo);
+
+    if (0 != EBO_QuadIndices) glDeleteBuffers(1, &EBO_QuadIndices);
+    EBO_QuadIndices = ebo;
+    quad_index_capacity = capacity;
+}
+
+void bindQuadIndexBuffer() {
+    glBindVertexArray(VAO_QuadIndices);
+}
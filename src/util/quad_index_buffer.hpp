@@ -0,0 +1,22 @@
+#ifndef QUAD_INDEX_BUFFER_HPP
+#define QUAD_INDEX_BUFFER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/gl.h>
+
+/*
+ * One index buffer shared by every chunk, quad k is drawn with the indices
+ * 4k + { 0, 1, 2, 0, 2, 3 }. chunk.vert maps each slot to a corner of
+ * quad k and picks the triangle diagonal, so no chunk needs its own indices.
+ *
+ * The buffer is attached to a VAO that is also shared, quads are pulled
+ * from each chunk's SSBO so the VAO carries nothing else.
+*/
+
+void setupQuadIndexBuffer();
+void reserveQuadIndexBuffer(GLsizei num_quads);
+void bindQuadIndexBuffer();
+
+#endif
@@ -12,15 +12,33 @@ void AABB::translate(const ChunkPosition chunk) {
     vmax = glm::vec3(chunk_model * glm::vec4(vmax.x, vmax.y, vmax.z, 1.0f));
 }
 
-void AABB::updateWithCubeFace(const Direction face, const LocalPosition voxel_origin) {
-    const glm::vec3 v0 = voxel_origin + FACE_VERTICES.at(face).at(0);
-    const glm::vec3 v1 = voxel_origin + FACE_VERTICES.at(face).at(1);
-    const glm::vec3 v2 = voxel_origin + FACE_VERTICES.at(face).at(2);
-    const glm::vec3 v3 = voxel_origin + FACE_VERTICES.at(face).at(3);
+void AABB::updateWithQuad(const Direction face, const LocalPosition voxel_origin, const LocalPosition quad_size) {
+    const glm::vec3 v0 = voxel_origin + FACE_VERTICES.at(face).at(0) * quad_size;
+    const glm::vec3 v1 = voxel_origin + FACE_VERTICES.at(face).at(1) * quad_size;
+    const glm::vec3 v2 = voxel_origin + FACE_VERTICES.at(face).at(2) * quad_size;
+    const glm::vec3 v3 = voxel_origin + FACE_VERTICES.at(face).at(3) * quad_size;
 
     const glm::vec3 min_v = glm::min(v0, v1, v2, v3);
     const glm::vec3 max_v = glm::max(v0, v1, v2, v3);
 
     vmin = glm::min(vmin, min_v);
     vmax = glm::max(vmax, max_v);
+}
+
+bool AABB::isInFrustum(const std::array<glm::vec4, 6>& frustum_planes) const {
+    for (auto const &g : frustum_planes) {
+        if ((glm::dot(g, glm::vec4(vmin.x, vmin.y, vmin.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmax.x, vmin.y, vmin.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmin.x, vmax.y, vmin.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmax.x, vmax.y, vmin.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmin.x, vmin.y, vmax.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmax.x, vmin.y, vmax.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmin.x, vmax.y, vmax.z, 1.0f)) < 0.0) &&
+            (glm::dot(g, glm::vec4(vmax.x, vmax.y, vmax.z, 1.0f)) < 0.0))
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
\ No newline at end of file
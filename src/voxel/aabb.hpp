@@ -1,7 +1,11 @@
 #ifndef AABB_HPP
 #define AABB_HPP
 
+#include <array>
+
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/geometric.hpp>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/extended_min_max.hpp>
@@ -14,7 +18,9 @@ struct AABB {
 
     void reset();
     void translate(ChunkPosition);
-    void updateWithCubeFace(Direction face, LocalPosition voxel_origin);
+    void updateWithQuad(Direction face, LocalPosition voxel_origin, LocalPosition quad_size);
+
+    [[nodiscard]] bool isInFrustum(const std::array<glm::vec4, 6>& frustum_planes) const;
 };
 
 #endif
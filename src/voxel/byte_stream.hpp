@@ -0,0 +1,83 @@
+#ifndef BYTE_STREAM_HPP
+#define BYTE_STREAM_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace chisel {
+    // Values are stored in native byte order, saves are not meant to move between platforms of different endianness
+    class ByteWriter {
+        std::vector<uint8_t>& bytes;
+    public:
+        explicit ByteWriter(std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+        void write(const void* data, const size_t size) {
+            const auto* p_data = static_cast<const uint8_t*>(data);
+            bytes.insert(bytes.end(), p_data, p_data + size);
+        }
+
+        template<typename T>
+        void write(const T value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(&value, sizeof(T));
+        }
+
+        // 7 bits per byte, low bits first, the high bit is set on every byte but the last
+        void writeVarint(uint32_t value) {
+            while (value >= 0x80) {
+                bytes.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+
+            bytes.push_back(static_cast<uint8_t>(value));
+        }
+    };
+
+    // Every read is bounds checked, a failed read leaves the reader exhausted so later reads fail too
+    class ByteReader {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+    public:
+        ByteReader(const uint8_t* data, const size_t size) : data(data), size(size) {}
+
+        [[nodiscard]] bool read(void* destination, const size_t num_bytes) {
+            if (num_bytes > size - offset) {
+                offset = size;
+                return false;
+            }
+
+            std::memcpy(destination, data + offset, num_bytes);
+            offset += num_bytes;
+            return true;
+        }
+
+        template<typename T>
+        [[nodiscard]] bool read(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            return read(&value, sizeof(T));
+        }
+
+        // At most 5 bytes, anything over 32 bits or left unterminated after them is rejected
+        [[nodiscard]] bool readVarint(uint32_t& value) {
+            value = 0;
+
+            for (unsigned shift = 0; shift < 32 and offset < size; shift += 7) {
+                const uint8_t BYTE = data[offset++];
+
+                // The 5th byte only holds the top 4 bits and must end the varint
+                if (28 == shift and BYTE > 0x0F) break;
+                value |= static_cast<uint32_t>(BYTE & 0x7F) << shift;
+
+                if (0 == (BYTE & 0x80)) return true;
+            }
+
+            offset = size;
+            return false;
+        }
+    };
+}
+
+#endif
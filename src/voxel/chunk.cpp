@@ -1,65 +1,11 @@
 #include "chunk.hpp"
 
-#include <random>
+#include "chunk_codec.hpp"
 
-bool isVoxelAdjacentToChunkInXAxis(const LocalPosition voxel_origin, const Direction expected_adjacent) {
-    if (isVoxelAtChunkBoundaryNorth(voxel_origin) and Direction::North == expected_adjacent) {
-        return true;
-    }
-
-    if (isVoxelAtChunkBoundarySouth(voxel_origin) and Direction::South == expected_adjacent) {
-        return true;
-    }
-
-    return false;
-}
-
-bool isVoxelAdjacentToChunkInYAxis(const LocalPosition voxel_origin, const Direction expected_adjacent) {
-    if (isVoxelAtChunkBoundaryTop(voxel_origin) and Direction::Top == expected_adjacent) {
-        return true;
-    }
-
-    if (isVoxelAtChunkBoundaryBottom(voxel_origin) and Direction::Bottom == expected_adjacent) {
-        return true;
-    }
-
-    return false;
-}
-
-bool isVoxelAdjacentToChunkInZAxis(const LocalPosition voxel_origin, const Direction expected_adjacent) {
-    if (isVoxelAtChunkBoundaryEast(voxel_origin) and Direction::East == expected_adjacent) {
-        return true;
-    }
-
-    if (isVoxelAtChunkBoundaryWest(voxel_origin) and Direction::West == expected_adjacent) {
-        return true;
-    }
-
-    return false;
-}
-
-Vertex::Vertex(const int vertex_index, const LocalPosition &voxel_origin, const unsigned ao_id, const Direction face_direction, const chisel::types::VoxelID voxel_id) {
-    const unsigned VERTEX_FACE_ID = FACE_DIRECTION_TO_ID.at(face_direction);
-    const LocalPosition VERTEX_POSITION = voxel_origin + FACE_VERTICES.at(face_direction).at(vertex_index);
-
-    appendBits(VERTEX_POSITION.x, chisel::ChunkDataConstants::X_SIZE);
-    appendBits(VERTEX_POSITION.y, chisel::ChunkDataConstants::Y_SIZE);
-    appendBits(VERTEX_POSITION.z, chisel::ChunkDataConstants::Z_SIZE);
-    appendBits(ao_id,             chisel::ChunkDataConstants::AO_ID_SIZE);
-    appendBits(VERTEX_FACE_ID,    chisel::ChunkDataConstants::FACE_ID_SIZE);
-    appendBits(+voxel_id,         chisel::ChunkDataConstants::VOXEL_ID_SIZE);
-}
-
-void Vertex::appendBits(const unsigned data, const unsigned size) {
-    packed_data <<= size;
-    packed_data |= data;
-}
-
-float Chunk::getNoise(const int x, const int z) const {
-    using chisel::ChunkDataConstants::CHUNK_SIZE;
-    using chisel::ChunkDataConstants::CHUNK_HEIGHT;
-
-    return height_map.at(z * CHUNK_SIZE + x);
+// Index of the voxel within its section, sections share the x and z layout of the whole chunk
+size_t toSectionIndex(const LocalPosition local) {
+    using namespace chisel::ChunkDataConstants;
+    return local.x + CHUNK_SIZE * local.z + CHUNK_AREA * (local.y % SECTION_HEIGHT);
 }
 
 std::vector<std::pair<float, int>> spline_points {
@@ -83,1086 +29,532 @@ unsigned getHeight(float noise) {
     return 0;
 }
 
-void Chunk::buildVoxels() {
-    terrain_noise_engine.getHeightMap(height_map, position, Biome::Plains);
-    const auto& block_registry = chisel::BlockRegistry::getInstance();
-
-    chisel::types::VoxelID water_id = block_registry.getVoxelID("chisel::water");
-    chisel::types::VoxelID stone_id = block_registry.getVoxelID("chisel::stone");
-    chisel::types::VoxelID dirt_id = block_registry.getVoxelID("chisel::dirt");
-    chisel::types::VoxelID grass_block_id = block_registry.getVoxelID("chisel::grass_block");
-    chisel::types::VoxelID sand_id = block_registry.getVoxelID("chisel::sand");
-
-    std::random_device dev;
-    std::mt19937 rng(dev());
-    std::uniform_int_distribution<std::mt19937::result_type> dist6(1,6);
-
-    setEmpty(false);
-
-    for (unsigned x = 0; x < chisel::ChunkDataConstants::CHUNK_SIZE; x++) {
-        for (unsigned z = 0; z < chisel::ChunkDataConstants::CHUNK_SIZE; z++) {
-            glm::vec3 voxel_position = Conversion::toWorld(LocalPosition(x, 0, z), position);
-            voxel_position /= static_cast<float>(chisel::ChunkDataConstants::CHUNK_SIZE);
-
-            const unsigned y_level = getHeight(getNoise(x, z));
-
-            chisel::types::VoxelID id {};
-            for (unsigned y = 0; y < y_level; y++) {
-
-                if (y <= 8) {
-                    id = stone_id;
-                } else if (8 < y and y <= 11) {
-                    id = sand_id;
-                } else if (11 < y and y <= 16) {
-                    id = dirt_id;
-                } else if (16 < y and y <= 36) {
-                    id = grass_block_id;
-                } else {
-                    id = stone_id;
-                }
-
-                setVoxelIDAtPosition(id, { x, y, z });
-            }
-        }
-    }
-}
-
-void Chunk::resetVoxels() {
-    std::fill(std::begin(voxel_ids), std::end(voxel_ids), chisel::AIR_ID);
-    setEmpty(true);
-}
-
-void Chunk::buildMesh() {
-    if (isEmpty()) return;
-
-    GLuint index = 0;
-    std::array<unsigned, 4>&& AO {};
-
-    bounding_box.reset();
-
-    for (unsigned x = 0; x < chisel::ChunkDataConstants::CHUNK_SIZE; x++) {
-        for (unsigned z = 0; z < chisel::ChunkDataConstants::CHUNK_SIZE; z++) {
-            for (unsigned y = 0; y < chisel::ChunkDataConstants::CHUNK_HEIGHT; y++) {
-                LocalPosition voxel_origin { x, y, z };
-                if (isVoidAt(voxel_origin)) continue;
-                const chisel::types::VoxelID voxel_id = getVoxelID(voxel_origin);
-
-                if (isVoidTopNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::Top, voxel_origin);
-
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+3, index+2, index, index+2, index+1 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+3, index+2, index+1, index, index+3 });
-                    }
-
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::Top, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::Top, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::Top, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::Top, voxel_id);
-
-                    bounding_box.updateWithCubeFace(Direction::Top, voxel_origin);
-
-                    index += 4;
-                }
-
-                if (isVoidBottomNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::Bottom, voxel_origin);
-
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+2, index+3, index, index+1, index+2 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+2, index+3, index+1, index+3, index });
-                    }
-
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::Bottom, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::Bottom, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::Bottom, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::Bottom, voxel_id);
-
-                    bounding_box.updateWithCubeFace(Direction::Bottom, voxel_origin);
-
-                    index += 4;
-                }
-
-                if (isVoidNorthNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::North, voxel_origin);
-
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+1, index+2, index, index+2, index+3 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+2, index+3, index+1, index+3, index });
-                    }
-
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::North, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::North, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::North, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::North, voxel_id);
-
-                    bounding_box.updateWithCubeFace(Direction::North, voxel_origin);
-
-                    index += 4;
-                }
-
-                if (isVoidSouthNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::South, voxel_origin);
-
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+2, index+1, index, index+3, index+2 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+3, index+2, index+1, index, index+3 });
-                    }
-
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::South, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::South, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::South, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::South, voxel_id);
-
-                    bounding_box.updateWithCubeFace(Direction::South, voxel_origin);
-
-                    index += 4;
-                }
+struct TerrainVoxelIDs {
+    chisel::types::VoxelID stone {};
+    chisel::types::VoxelID sand {};
+    chisel::types::VoxelID dirt {};
+    chisel::types::VoxelID grass_block {};
+};
 
-                if (isVoidEastNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::East, voxel_origin);
+// The registry is filled once at startup, so the names are only looked up on the first call
+const TerrainVoxelIDs& getTerrainVoxelIDs() {
+    static const TerrainVoxelIDs IDS = [] {
+        const auto& block_registry = chisel::BlockRegistry::getInstance();
 
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+2, index+1, index, index+3, index+2 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+3, index+2, index+1, index, index+3 });
-                    }
+        return TerrainVoxelIDs {
+            block_registry.getVoxelID("chisel::stone"),
+            block_registry.getVoxelID("chisel::sand"),
+            block_registry.getVoxelID("chisel::dirt"),
+            block_registry.getVoxelID("chisel::grass_block")
+        };
+    }();
 
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::East, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::East, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::East, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::East, voxel_id);
+    return IDS;
+}
 
-                    bounding_box.updateWithCubeFace(Direction::East, voxel_origin);
+// Strata only depend on the world height
+chisel::types::VoxelID getStratumVoxelID(const int y) {
+    const TerrainVoxelIDs& ids = getTerrainVoxelIDs();
 
-                    index += 4;
-                }
+    if (y <= 8) return ids.stone;
+    if (y <= 11) return ids.sand;
+    if (y <= 16) return ids.dirt;
+    if (y <= 36) return ids.grass_block;
+    return ids.stone;
+}
 
-                if (isVoidWestNeighbor(voxel_origin)) {
-                    AO = getVertexAO(Direction::West, voxel_origin);
+// Columns are solid from their top all the way down, so each column is a few stratum spans under one
+// span of air. They are handed over as runs, the way snapshots are loaded
+void Chunk::buildVoxels(const HeightMap& height_map) {
+    using namespace chisel::ChunkDataConstants;
 
-                    if (AO.at(0) + AO.at(2) > AO.at(1) + AO.at(3)) {
-                        mesh.indices.insert(mesh.indices.end(), { index, index+1, index+2, index, index+2, index+3 });
-                    } else {
-                        mesh.indices.insert(mesh.indices.end(), { index+1, index+2, index+3, index+1, index+3, index });
-                    }
+    const int CHUNK_BOTTOM = position.y * static_cast<int>(CHUNK_HEIGHT);
 
-                    mesh.vertices.emplace_back(0, voxel_origin, AO.at(0), Direction::West, voxel_id);
-                    mesh.vertices.emplace_back(1, voxel_origin, AO.at(1), Direction::West, voxel_id);
-                    mesh.vertices.emplace_back(2, voxel_origin, AO.at(2), Direction::West, voxel_id);
-                    mesh.vertices.emplace_back(3, voxel_origin, AO.at(3), Direction::West, voxel_id);
+    // Strata are the same for every column, as spans of layers from the bottom of the chunk
+    std::vector<chisel::VoxelRun> strata {};
 
-                    bounding_box.updateWithCubeFace(Direction::West, voxel_origin);
+    for (unsigned y = 0; y < CHUNK_HEIGHT; y++) {
+        const chisel::types::VoxelID STRATUM_ID = getStratumVoxelID(CHUNK_BOTTOM + static_cast<int>(y));
 
-                    index += 4;
-                }
-            }
-        }
+        if (not strata.empty() and STRATUM_ID == strata.back().voxel_id) strata.back().length++;
+        else strata.push_back({ STRATUM_ID, 1 });
     }
 
-    bounding_box.translate(position);
-
-    glCreateBuffers(1, &mesh.ssbo_vertices);
-    glCreateBuffers(1, &mesh.ebo);
-    glCreateVertexArrays(1, &mesh.vao);
+    std::vector<chisel::VoxelRun> runs {};
 
-    const auto VERTEX_BUFFER_SIZE = static_cast<GLsizeiptr>(mesh.vertices.size() * sizeof(Vertex));
-    const auto VERTEX_DATA = reinterpret_cast<void *>(mesh.vertices.data());
-    const auto ELEMENT_BUFFER_SIZE = static_cast<GLsizeiptr>(mesh.indices.size() * sizeof(GLuint));
-    const auto ELEMENT_DATA = reinterpret_cast<void *>(mesh.indices.data());
-    glNamedBufferStorage(mesh.ssbo_vertices, VERTEX_BUFFER_SIZE, VERTEX_DATA, 0);
-    glNamedBufferStorage(mesh.ebo, ELEMENT_BUFFER_SIZE, ELEMENT_DATA, 0);
-    glVertexArrayElementBuffer(mesh.vao, mesh.ebo);
+    const auto appendRun = [&runs](const chisel::types::VoxelID voxel_id, const uint32_t length) {
+        if (not runs.empty() and voxel_id == runs.back().voxel_id) runs.back().length += length;
+        else runs.push_back({ voxel_id, length });
+    };
 
-    setBuilt(true);
-}
+    for (size_t column = 0; column < CHUNK_AREA; column++) {
+        const auto y_level = static_cast<int>(getHeight(height_map[column]));
+        const auto LOCAL_TOP = static_cast<uint32_t>(std::clamp(y_level - CHUNK_BOTTOM, 0, static_cast<int>(CHUNK_HEIGHT)));
 
-void Chunk::destroyMesh() {
-    if (not isBuilt()) return;
-
-    glDeleteVertexArrays(1, &mesh.vao);
-    glDeleteBuffers(1, &mesh.ssbo_vertices);
-    glDeleteBuffers(1, &mesh.ebo);
-    mesh.vertices.clear();
-    mesh.indices.clear();
-
-    setBuilt(false);
-}
-
-void Chunk::render() const {
-    if (not isBuilt()) return;
-
-    glBindVertexArray(mesh.vao);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mesh.ssbo_vertices);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT, 0);
-}
-
-bool Chunk::isChunkVisible(const std::array<glm::vec4, 6>& frustum_planes) const {
-    if (isEmpty() or not isBuilt()) return false;
-
-    const glm::vec3& vmin = bounding_box.vmin;
-    const glm::vec3& vmax = bounding_box.vmax;
-
-    for (auto const &g : frustum_planes) {
-        if ((glm::dot(g, glm::vec4(vmin.x, vmin.y, vmin.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmax.x, vmin.y, vmin.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmin.x, vmax.y, vmin.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmax.x, vmax.y, vmin.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmin.x, vmin.y, vmax.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmax.x, vmin.y, vmax.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmin.x, vmax.y, vmax.z, 1.0f)) < 0.0) &&
-            (glm::dot(g, glm::vec4(vmax.x, vmax.y, vmax.z, 1.0f)) < 0.0))
-        {
-            return false;
+        uint32_t remaining = LOCAL_TOP;
+        for (auto it = strata.begin(); remaining > 0; ++it) {
+            const uint32_t LENGTH = std::min(remaining, it->length);
+            appendRun(it->voxel_id, LENGTH);
+            remaining -= LENGTH;
         }
+
+        if (LOCAL_TOP < CHUNK_HEIGHT) appendRun(chisel::AIR_ID, CHUNK_HEIGHT - LOCAL_TOP);
     }
 
-    return true;
+    assignRuns(runs);
 }
 
-bool Chunk::isBuilt() const {
-    return is_built;
-}
+// Solid ground can rise and sink this many voxels around the heightmap, which makes overhangs
+constexpr float SURFACE_BLEND_HEIGHT = 16.0f;
 
-bool Chunk::isEmpty() const {
-    return is_empty;
-}
+// Where the noise falls below this solid ground is hollowed out into caves
+constexpr float CAVE_THRESHOLD = -0.55f;
 
-void Chunk::setBuilt(const bool state) {
-    is_built = state;
-}
+// Noise is sampled every DENSITY_STEP voxels and interpolated in between
+constexpr unsigned DENSITY_STEP = 4;
+constexpr unsigned DENSITY_SAMPLES_XZ = chisel::ChunkDataConstants::CHUNK_SIZE / DENSITY_STEP + 1;
+constexpr unsigned DENSITY_SAMPLES_Y = chisel::ChunkDataConstants::SECTION_HEIGHT / DENSITY_STEP + 1;
+static_assert(chisel::ChunkDataConstants::SECTION_HEIGHT % DENSITY_STEP == 0, "Density samples must line up with sections");
 
-void Chunk::setEmpty(const bool state) {
-    is_empty = state;
+bool isDense(const float surface_distance, const float noise) {
+    return noise > CAVE_THRESHOLD and surface_distance / SURFACE_BLEND_HEIGHT + noise > 0.0f;
 }
 
-bool Chunk::isVoidAt(const LocalPosition local) const {
-    return chisel::AIR_ID == getVoxelID(local);
+float lerp(const float a, const float b, const float t) {
+    return a + (b - a) * t;
 }
 
-chisel::types::VoxelID Chunk::getVoxelID(const LocalPosition local) const {
-    return voxel_ids.at(Conversion::toIndex(local));
-}
+/*
+ * Solid where the noise pushes the ground above the heightmap surface, and
+ * not carved out by a cave.
+ *
+ * Interpolated noise never leaves the range of the coarse samples, so those
+ * alone decide whether a whole section is air or solid. Sections well above
+ * the surface do not sample any noise at all.
+*/
+void Chunk::buildDensityVoxels(const HeightMap& height_map, TerrainNoise& terrain_noise) {
+    using namespace chisel::ChunkDataConstants;
 
-void Chunk::setVoxelIDAtPosition(const chisel::types::VoxelID voxel_id, const LocalPosition local) {
-    try {
-        voxel_ids.at(Conversion::toIndex(local)) = voxel_id;
-    } catch (std::out_of_range& e) {
-        std::cerr << local.x << ' ' << local.y << ' ' << local.z << '\n';
-        std::cerr << e.what() << '\n';
-    }
-}
+    const WorldPosition CHUNK_ORIGIN = Conversion::chunkToWorld(position);
 
-std::array<unsigned, 4> Chunk::getVertexAO(const Direction face, const LocalPosition voxel_origin) const {
-    std::array<unsigned, 4> face_ao {};
-
-    unsigned a = 1;
-    unsigned b = 1;
-    unsigned c = 1;
-    unsigned d = 1;
-    unsigned e = 1;
-    unsigned f = 1;
-    unsigned g = 1;
-    unsigned h = 1;
-
-    if (Direction::Top == face) {
-        a = isVoidTopSouthNeighbor(voxel_origin);
-        b = isVoidTopSouthWestNeighbor(voxel_origin);
-        c = isVoidTopWestNeighbor(voxel_origin);
-        d = isVoidTopNorthWestNeighbor(voxel_origin);
-        e = isVoidTopNorthNeighbor(voxel_origin);
-        f = isVoidTopNorthEastNeighbor(voxel_origin);
-        g = isVoidTopEastNeighbor(voxel_origin);
-        h = isVoidTopSouthEastNeighbor(voxel_origin);
-    } else if (Direction::Bottom == face) {
-        a = isVoidBottomSouthNeighbor(voxel_origin);
-        b = isVoidBottomSouthWestNeighbor(voxel_origin);
-        c = isVoidBottomWestNeighbor(voxel_origin);
-        d = isVoidBottomNorthWestNeighbor(voxel_origin);
-        e = isVoidBottomNorthNeighbor(voxel_origin);
-        f = isVoidBottomNorthEastNeighbor(voxel_origin);
-        g = isVoidBottomEastNeighbor(voxel_origin);
-        h = isVoidBottomSouthEastNeighbor(voxel_origin);
-    } else if (Direction::North == face) {
-        a = isVoidBottomNorthNeighbor(voxel_origin);
-        b = isVoidBottomNorthWestNeighbor(voxel_origin);
-        c = isVoidNorthWestNeighbor(voxel_origin);
-        d = isVoidTopNorthWestNeighbor(voxel_origin);
-        e = isVoidTopNorthNeighbor(voxel_origin);
-        f = isVoidTopNorthEastNeighbor(voxel_origin);
-        g = isVoidNorthEastNeighbor(voxel_origin);
-        h = isVoidBottomNorthEastNeighbor(voxel_origin);
-    } else if (Direction::South == face) {
-        a = isVoidBottomSouthNeighbor(voxel_origin);
-        b = isVoidBottomSouthWestNeighbor(voxel_origin);
-        c = isVoidSouthWestNeighbor(voxel_origin);
-        d = isVoidTopSouthWestNeighbor(voxel_origin);
-        e = isVoidTopSouthNeighbor(voxel_origin);
-        f = isVoidTopSouthEastNeighbor(voxel_origin);
-        g = isVoidSouthEastNeighbor(voxel_origin);
-        h = isVoidBottomSouthEastNeighbor(voxel_origin);
-    } else if (Direction::East == face) {
-        a = isVoidBottomEastNeighbor(voxel_origin);
-        b = isVoidBottomSouthEastNeighbor(voxel_origin);
-        c = isVoidSouthEastNeighbor(voxel_origin);
-        d = isVoidTopSouthEastNeighbor(voxel_origin);
-        e = isVoidTopEastNeighbor(voxel_origin);
-        f = isVoidTopNorthEastNeighbor(voxel_origin);
-        g = isVoidNorthEastNeighbor(voxel_origin);
-        h = isVoidBottomNorthEastNeighbor(voxel_origin);
-    } else if (Direction::West == face) {
-        a = isVoidBottomWestNeighbor(voxel_origin);
-        b = isVoidBottomSouthWestNeighbor(voxel_origin);
-        c = isVoidSouthWestNeighbor(voxel_origin);
-        d = isVoidTopSouthWestNeighbor(voxel_origin);
-        e = isVoidTopWestNeighbor(voxel_origin);
-        f = isVoidTopNorthWestNeighbor(voxel_origin);
-        g = isVoidNorthWestNeighbor(voxel_origin);
-        h = isVoidBottomNorthWestNeighbor(voxel_origin);
+    std::array<float, CHUNK_AREA> surfaces {};
+    for (size_t column = 0; column < CHUNK_AREA; column++) {
+        surfaces[column] = static_cast<float>(getHeight(height_map[column]));
     }
 
-    face_ao.at(0) = a + b + c;
-    face_ao.at(1) = c + d + e;
-    face_ao.at(2) = e + f + g;
-    face_ao.at(3) = g + h + a;
+    const auto [MIN_SURFACE, MAX_SURFACE] = std::minmax_element(surfaces.begin(), surfaces.end());
+    std::fill(std::begin(column_masks), std::end(column_masks), 0);
 
-    return face_ao;
-}
+    std::vector<float> samples {};
+    std::array<float, DENSITY_SAMPLES_XZ * DENSITY_SAMPLES_XZ> layer_samples {};
+    std::array<chisel::types::VoxelID, SECTION_VOLUME> section_ids {};
 
-bool Chunk::isVoidEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
+    for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+        const unsigned SECTION_BOTTOM = section * SECTION_HEIGHT;
+        const auto SECTION_BOTTOM_Y = static_cast<float>(CHUNK_ORIGIN.y + static_cast<int>(SECTION_BOTTOM));
+        const float SECTION_TOP_Y = SECTION_BOTTOM_Y + static_cast<float>(SECTION_HEIGHT - 1);
 
-    if (IS_ADJACENT_EAST) {
-        if (nullptr == neighbors.east or neighbors.east->isEmpty()) return true;
-        neighbor_voxel.z = 0;
-        return neighbors.east->isVoidAt(neighbor_voxel);
-    }
+        if (not isDense(*MAX_SURFACE - SECTION_BOTTOM_Y, 1.0f)) {
+            sections[section].reset();
+            continue;
+        }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-    return isVoidAt(neighbor_voxel);
-}
+        const WorldPosition SECTION_ORIGIN { CHUNK_ORIGIN.x, static_cast<int>(SECTION_BOTTOM_Y), CHUNK_ORIGIN.z };
+        const glm::ivec3 NUM_SAMPLES { DENSITY_SAMPLES_XZ, DENSITY_SAMPLES_Y, DENSITY_SAMPLES_XZ };
+        terrain_noise.getDensityGrid(samples, SECTION_ORIGIN, NUM_SAMPLES, static_cast<float>(DENSITY_STEP));
 
-bool Chunk::isVoidWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+        const auto [MIN_NOISE, MAX_NOISE] = std::minmax_element(samples.begin(), samples.end());
 
-    if (IS_ADJACENT_WEST) {
-        if (nullptr == neighbors.west or neighbors.west->isEmpty()) return true;
-        neighbor_voxel.z = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        return neighbors.west->isVoidAt(neighbor_voxel);
-    }
+        if (not isDense(*MAX_SURFACE - SECTION_BOTTOM_Y, *MAX_NOISE)) {
+            sections[section].reset();
+            continue;
+        }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-    return isVoidAt(neighbor_voxel);
-}
+        const bool IS_SOLID = isDense(*MIN_SURFACE - SECTION_TOP_Y, *MIN_NOISE);
 
-bool Chunk::isVoidNorthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
+        for (unsigned layer = 0; layer < SECTION_HEIGHT; layer++) {
+            const unsigned LOCAL_Y = SECTION_BOTTOM + layer;
+            const float Y = SECTION_BOTTOM_Y + static_cast<float>(layer);
+            const chisel::types::VoxelID STRATUM_ID = getStratumVoxelID(static_cast<int>(Y));
+            chisel::types::VoxelID* layer_ids = section_ids.data() + layer * CHUNK_AREA;
 
-    if (IS_ADJACENT_NORTH) {
-        if (nullptr == neighbors.north or neighbors.north->isEmpty()) return true;
-        neighbor_voxel.x = 0;
-        return neighbors.north->isVoidAt(neighbor_voxel);
-    }
+            if (IS_SOLID) {
+                std::fill(layer_ids, layer_ids + CHUNK_AREA, STRATUM_ID);
+                for (auto& column : column_masks) column |= static_cast<ColumnMask>(1) << LOCAL_Y;
+                continue;
+            }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-    return isVoidAt(neighbor_voxel);
-}
+            // Noise of this layer at every coarse x and z, interpolated between the samples below and above
+            const unsigned SAMPLE_Y = layer / DENSITY_STEP;
+            const float T_Y = static_cast<float>(layer % DENSITY_STEP) / DENSITY_STEP;
 
-bool Chunk::isVoidSouthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
+            for (unsigned k = 0; k < DENSITY_SAMPLES_XZ; k++) {
+                for (unsigned i = 0; i < DENSITY_SAMPLES_XZ; i++) {
+                    const size_t BELOW = i + DENSITY_SAMPLES_XZ * (SAMPLE_Y + DENSITY_SAMPLES_Y * k);
+                    const size_t ABOVE = BELOW + DENSITY_SAMPLES_XZ;
+                    layer_samples[i + DENSITY_SAMPLES_XZ * k] = lerp(samples[BELOW], samples[ABOVE], T_Y);
+                }
+            }
 
-    if (IS_ADJACENT_SOUTH) {
-        if (nullptr == neighbors.south or neighbors.south->isEmpty()) return true;
-        neighbor_voxel.x = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        return neighbors.south->isVoidAt(neighbor_voxel);
-    }
+            for (unsigned z = 0; z < CHUNK_SIZE; z++) {
+                const unsigned K = z / DENSITY_STEP;
+                const float T_Z = static_cast<float>(z % DENSITY_STEP) / DENSITY_STEP;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-    return isVoidAt(neighbor_voxel);
-}
+                for (unsigned x = 0; x < CHUNK_SIZE; x++) {
+                    const unsigned I = x / DENSITY_STEP;
+                    const float T_X = static_cast<float>(x % DENSITY_STEP) / DENSITY_STEP;
 
-bool Chunk::isVoidTopNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
+                    const float NEAR = lerp(layer_samples[I + DENSITY_SAMPLES_XZ * K], layer_samples[I + 1 + DENSITY_SAMPLES_XZ * K], T_X);
+                    const float FAR = lerp(layer_samples[I + DENSITY_SAMPLES_XZ * (K + 1)], layer_samples[I + 1 + DENSITY_SAMPLES_XZ * (K + 1)], T_X);
 
-    if (IS_ADJACENT_TOP) {
-        return true;
-    }
+                    const size_t COLUMN = x + CHUNK_SIZE * z;
+                    const bool IS_DENSE = isDense(surfaces[COLUMN] - Y, lerp(NEAR, FAR, T_Z));
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-    return isVoidAt(neighbor_voxel);
-}
-
-bool Chunk::isVoidBottomNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
+                    layer_ids[COLUMN] = IS_DENSE ? STRATUM_ID : chisel::AIR_ID;
+                    column_masks[COLUMN] |= static_cast<ColumnMask>(IS_DENSE) << LOCAL_Y;
+                }
+            }
+        }
 
-    if (IS_ADJACENT_BOTTOM) {
-        return true;
+        sections[section].assign(section_ids.data());
     }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-    return isVoidAt(neighbor_voxel);
 }
 
-bool Chunk::isVoidNorthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_EAST) {
-        if (nullptr == neighbors.north_east or neighbors.north_east->isEmpty()) return true;
-        neighbor_voxel.x = 0;
-        neighbor_voxel.z = 0;
-        return neighbors.north_east->isVoidAt(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidEastNeighbor(neighbor_voxel);
+void Chunk::resetVoxels() {
+    for (auto& section : sections) {
+        section.reset();
     }
 
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
+    std::fill(std::begin(column_masks), std::end(column_masks), 0);
+    is_dirty = false;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::East);
-    return isVoidAt(neighbor_voxel);
+    edits.clear();
+    persistence = ChunkPersistence::Delta;
 }
 
-bool Chunk::isVoidNorthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+// Serialized size of one edit, a voxel index and a voxel ID
+constexpr size_t EDIT_SIZE = sizeof(uint16_t) + sizeof(chisel::types::VoxelID);
+static_assert(chisel::ChunkDataConstants::CHUNK_VOLUME <= UINT16_MAX + 1, "Edited voxel indices are saved on 16 bits");
 
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_WEST) {
-        if (nullptr == neighbors.north_west or neighbors.north_west->isEmpty()) return true;
-        neighbor_voxel.x = 0;
-        neighbor_voxel.z = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        return neighbors.north_west->isVoidAt(neighbor_voxel);
-    }
+// The smaller of the two records is written, a chunk edited densely enough ends up saved as a snapshot
+void ChunkSaveData::serialize(std::vector<uint8_t>& bytes) const {
+    using namespace chisel::ChunkDataConstants;
 
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
+    chisel::ByteWriter writer { bytes };
+    const size_t START = bytes.size();
 
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidWestNeighbor(neighbor_voxel);
+    std::array<chisel::types::VoxelID, CHUNK_VOLUME> voxel_ids {};
+    for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+        sections[section].copyTo(voxel_ids.data() + section * SECTION_VOLUME);
     }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::West);
-    return isVoidAt(neighbor_voxel);
-}
+    writer.write(ChunkPersistence::Snapshot);
+    chisel::ChunkCodec::encode(voxel_ids.data(), writer);
 
-bool Chunk::isVoidSouthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
+    const size_t SNAPSHOT_SIZE = bytes.size() - START;
+    if (ChunkPersistence::Snapshot == persistence or edits.size() * EDIT_SIZE >= SNAPSHOT_SIZE) return;
 
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_EAST) {
-        if (nullptr == neighbors.south_east or neighbors.south_east->isEmpty()) return true;
-        neighbor_voxel.x = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        neighbor_voxel.z = 0;
-        return neighbors.south_east->isVoidAt(neighbor_voxel);
-    }
+    bytes.resize(START);
+    writer.write(ChunkPersistence::Delta);
 
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
+    std::vector<std::pair<VoxelIndex, chisel::types::VoxelID>> sorted_edits = edits;
+    std::sort(sorted_edits.begin(), sorted_edits.end());
 
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidSouthNeighbor(neighbor_voxel);
+    writer.write(static_cast<uint32_t>(sorted_edits.size()));
+    for (auto const& [index, voxel_id] : sorted_edits) {
+        writer.write(static_cast<uint16_t>(index));
+        writer.write(voxel_id);
     }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::East);
-    return isVoidAt(neighbor_voxel);
 }
 
-bool Chunk::isVoidSouthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
-
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_WEST) {
-        if (nullptr == neighbors.south_west or neighbors.south_west->isEmpty()) return true;
-        neighbor_voxel.x = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        neighbor_voxel.z = chisel::ChunkDataConstants::CHUNK_SIZE-1;
-        return neighbors.south_west->isVoidAt(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::West);
-    return isVoidAt(neighbor_voxel);
+// Copies the palettes as they are, nothing is decoded or encoded here
+ChunkSaveData Chunk::getSaveData() const {
+    return ChunkSaveData { sections, { edits.begin(), edits.end() }, persistence };
 }
 
-bool Chunk::isVoidTopNorthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
+// A delta only restores the edits, the caller generates the chunk and replays them
+bool Chunk::deserialize(const uint8_t* bytes, const size_t size) {
+    chisel::ByteReader reader { bytes, size };
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_NORTH) {
-        return true;
-    }
-
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
+    ChunkPersistence saved_persistence {};
+    if (not reader.read(saved_persistence)) return false;
 
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidTopNeighbor(neighbor_voxel);
+    const bool IS_LOADED = ChunkPersistence::Snapshot == saved_persistence ? deserializeSnapshot(reader) : deserializeDelta(reader);
+    if (not IS_LOADED) {
+        resetVoxels();
+        return false;
     }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::North);
-    return isVoidAt(neighbor_voxel);
+    is_dirty = false;
+    return true;
 }
 
-bool Chunk::isVoidTopSouthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-
-    if (IS_ADJACENT_TOP and IS_ADJACENT_SOUTH) {
-        return true;
-    }
-
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidTopNeighbor(neighbor_voxel);
+// Loads a save that was never encoded the way deserialize would have, a delta again only restores the edits
+void Chunk::restore(ChunkSaveData&& save_data) {
+    if (ChunkPersistence::Snapshot == save_data.persistence) {
+        sections = std::move(save_data.sections);
+        rebuildColumnMasks();
+        edits.clear();
+    } else {
+        edits = { save_data.edits.begin(), save_data.edits.end() };
     }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::South);
-    return isVoidAt(neighbor_voxel);
+    persistence = save_data.persistence;
+    is_dirty = false;
 }
 
-bool Chunk::isVoidTopEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
+bool Chunk::deserializeSnapshot(chisel::ByteReader& reader) {
+    std::vector<chisel::VoxelRun> runs {};
+    if (not chisel::ChunkCodec::decode(reader, runs)) return false;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_EAST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidTopNeighbor(neighbor_voxel);
-    }
+    assignRuns(runs);
+    persistence = ChunkPersistence::Snapshot;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::East);
-    return isVoidAt(neighbor_voxel);
+    return true;
 }
 
-bool Chunk::isVoidTopWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+bool Chunk::deserializeDelta(chisel::ByteReader& reader) {
+    uint32_t num_edits = 0;
+    if (not reader.read(num_edits) or num_edits > chisel::ChunkDataConstants::CHUNK_VOLUME) return false;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_WEST) {
-        return true;
-    }
+    edits.clear();
+    edits.reserve(num_edits);
 
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
+    for (uint32_t i = 0; i < num_edits; i++) {
+        uint16_t index = 0;
+        chisel::types::VoxelID voxel_id {};
+        if (not reader.read(index) or not reader.read(voxel_id) or index >= chisel::ChunkDataConstants::CHUNK_VOLUME) return false;
 
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidTopNeighbor(neighbor_voxel);
+        edits.insert_or_assign(index, voxel_id);
     }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::West);
-    return isVoidAt(neighbor_voxel);
+    persistence = ChunkPersistence::Delta;
+    return true;
 }
 
-bool Chunk::isVoidTopNorthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_TOP and IS_ADJACENT_NORTH and IS_ADJACENT_EAST) {
-        return true;
-    }
+void Chunk::replayEdits() {
+    using namespace chisel::ChunkDataConstants;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidTopEastNeighbor(neighbor_voxel);
-    }
+    for (auto const& [index, voxel_id] : edits) {
+        const LocalPosition LOCAL {
+            index & CHUNK_SIZE_MASK,
+            index >> (X_SIZE + Z_SIZE),
+            (index >> X_SIZE) & CHUNK_SIZE_MASK
+        };
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidTopNorthNeighbor(neighbor_voxel);
+        applyVoxelID(voxel_id, LOCAL);
     }
-
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidNorthEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::East);
-        return isVoidTopNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::East);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::North);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::North | Direction::East);
-    return isVoidAt(neighbor_voxel);
 }
 
-bool Chunk::isVoidTopNorthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+// Column masks are not saved, they are rebuilt along with the sections. Runs are cut where they leave a
+// column or a section, so each section gets the runs of its own part of the columns
+void Chunk::assignRuns(const std::vector<chisel::VoxelRun>& runs) {
+    using namespace chisel::ChunkDataConstants;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_NORTH and IS_ADJACENT_WEST) {
-        return true;
-    }
+    constexpr ColumnMask FULL_COLUMN_MASK = (static_cast<ColumnMask>(1) << CHUNK_HEIGHT) - 1;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidTopWestNeighbor(neighbor_voxel);
-    }
+    std::fill(std::begin(column_masks), std::end(column_masks), 0);
+    std::array<std::vector<chisel::VoxelRun>, NUM_SECTIONS> section_runs {};
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidTopNorthNeighbor(neighbor_voxel);
-    }
+    const auto appendRun = [&section_runs](const unsigned section, const chisel::types::VoxelID voxel_id, const uint32_t length) {
+        std::vector<chisel::VoxelRun>& pieces = section_runs[section];
+        if (not pieces.empty() and voxel_id == pieces.back().voxel_id) pieces.back().length += length;
+        else pieces.push_back({ voxel_id, length });
+    };
 
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidNorthWestNeighbor(neighbor_voxel);
-    }
+    size_t position = 0;
 
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::West);
-        return isVoidTopNeighbor(neighbor_voxel);
-    }
+    for (const chisel::VoxelRun& run : runs) {
+        const bool IS_SOLID = chisel::AIR_ID != run.voxel_id;
 
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::West);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
+        for (size_t remaining = run.length; remaining > 0;) {
+            const size_t COLUMN = position / CHUNK_HEIGHT;
+            const auto Y = static_cast<unsigned>(position % CHUNK_HEIGHT);
 
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::North);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::North | Direction::West);
-    return isVoidAt(neighbor_voxel);
-}
+            // Whole columns, the bulk of long runs of air or stone, go to every section at once
+            if (0 == Y and remaining >= CHUNK_HEIGHT) {
+                const size_t NUM_COLUMNS = remaining / CHUNK_HEIGHT;
+                if (IS_SOLID) std::fill_n(column_masks.begin() + static_cast<std::ptrdiff_t>(COLUMN), NUM_COLUMNS, FULL_COLUMN_MASK);
 
-bool Chunk::isVoidTopSouthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_TOP and IS_ADJACENT_SOUTH and IS_ADJACENT_EAST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_TOP and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidTopEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_TOP and IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidTopSouthNeighbor(neighbor_voxel);
-    }
+                for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+                    appendRun(section, run.voxel_id, static_cast<uint32_t>(NUM_COLUMNS * SECTION_HEIGHT));
+                }
 
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidSouthEastNeighbor(neighbor_voxel);
-    }
+                position += NUM_COLUMNS * CHUNK_HEIGHT;
+                remaining -= NUM_COLUMNS * CHUNK_HEIGHT;
+                continue;
+            }
 
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::East);
-        return isVoidTopNeighbor(neighbor_voxel);
-    }
+            const auto LENGTH = static_cast<uint32_t>(std::min<size_t>(remaining, SECTION_HEIGHT - Y % SECTION_HEIGHT));
+            if (IS_SOLID) column_masks[COLUMN] |= ((static_cast<ColumnMask>(1) << LENGTH) - 1) << Y;
+            appendRun(Y / SECTION_HEIGHT, run.voxel_id, LENGTH);
 
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::East);
-        return isVoidSouthNeighbor(neighbor_voxel);
+            position += LENGTH;
+            remaining -= LENGTH;
+        }
     }
 
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::South);
-        return isVoidEastNeighbor(neighbor_voxel);
+    for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+        sections[section].assign(section_runs[section]);
     }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::South | Direction::East);
-    return isVoidAt(neighbor_voxel);
 }
 
-bool Chunk::isVoidTopSouthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_TOP = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Top);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+// Empty and uniform sections set their part of every column at once, only mixed ones are decoded
+void Chunk::rebuildColumnMasks() {
+    using namespace chisel::ChunkDataConstants;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_SOUTH and IS_ADJACENT_WEST) {
-        return true;
-    }
+    constexpr ColumnMask SECTION_MASK = (static_cast<ColumnMask>(1) << SECTION_HEIGHT) - 1;
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidTopWestNeighbor(neighbor_voxel);
-    }
+    std::fill(std::begin(column_masks), std::end(column_masks), 0);
+    std::array<chisel::types::VoxelID, SECTION_VOLUME> section_ids {};
 
-    if (IS_ADJACENT_TOP and IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidTopSouthNeighbor(neighbor_voxel);
-    }
+    for (unsigned section = 0; section < NUM_SECTIONS; section++) {
+        const unsigned SECTION_BOTTOM = section * SECTION_HEIGHT;
 
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top);
-        return isVoidSouthWestNeighbor(neighbor_voxel);
-    }
+        switch (sections[section].getState()) {
+            case chisel::SectionState::Empty:
+                break;
+            case chisel::SectionState::Uniform:
+                for (auto& column : column_masks) column |= SECTION_MASK << SECTION_BOTTOM;
+                break;
+            case chisel::SectionState::Mixed:
+                sections[section].copyTo(section_ids.data());
 
-    if (IS_ADJACENT_TOP) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::West);
-        return isVoidTopNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::West);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
+                for (unsigned layer = 0; layer < SECTION_HEIGHT; layer++) {
+                    const chisel::types::VoxelID* layer_ids = section_ids.data() + layer * CHUNK_AREA;
 
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::South);
-        return isVoidWestNeighbor(neighbor_voxel);
+                    for (size_t column = 0; column < CHUNK_AREA; column++) {
+                        column_masks[column] |= static_cast<ColumnMask>(chisel::AIR_ID != layer_ids[column]) << (SECTION_BOTTOM + layer);
+                    }
+                }
+                break;
+        }
     }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top | Direction::South | Direction::West);
-    return isVoidAt(neighbor_voxel);
 }
 
-bool Chunk::isVoidBottomNorthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
+void Chunk::uploadMesh(const ChunkMeshData &mesh_data) {
+    destroyMesh();
 
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_NORTH) {
-        return true;
-    }
+    bounding_box = mesh_data.bounding_box;
+    bounding_box.translate(position);
+    mesh.num_quads = static_cast<GLsizei>(mesh_data.quads.size());
+    reserveQuadIndexBuffer(mesh.num_quads);
 
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
+    glCreateBuffers(1, &mesh.ssbo_quads);
 
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
+    const auto QUAD_BUFFER_SIZE = static_cast<GLsizeiptr>(mesh_data.quads.size() * sizeof(Quad));
+    const auto QUAD_DATA = reinterpret_cast<const void *>(mesh_data.quads.data());
+    glNamedBufferStorage(mesh.ssbo_quads, QUAD_BUFFER_SIZE, QUAD_DATA, 0);
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::North);
-    return isVoidAt(neighbor_voxel);
+    setBuilt(true);
 }
 
-bool Chunk::isVoidBottomSouthNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_SOUTH) {
-        return true;
-    }
-
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
+void Chunk::destroyMesh() {
+    if (not isBuilt()) return;
 
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
+    glDeleteBuffers(1, &mesh.ssbo_quads);
+    mesh.num_quads = 0;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::South);
-    return isVoidAt(neighbor_voxel);
+    setBuilt(false);
 }
 
-bool Chunk::isVoidBottomEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_EAST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
-
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::East);
-    return isVoidAt(neighbor_voxel);
+size_t Chunk::getNumQuads() const {
+    return static_cast<size_t>(mesh.num_quads);
 }
 
-bool Chunk::isVoidBottomWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_WEST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
+size_t Chunk::getVoxelMemoryUsage() const {
+    size_t memory_usage = 0;
 
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidBottomNeighbor(neighbor_voxel);
+    for (auto const& section : sections) {
+        memory_usage += section.getMemoryUsage();
     }
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::West);
-    return isVoidAt(neighbor_voxel);
+    return memory_usage;
 }
 
-bool Chunk::isVoidBottomNorthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_NORTH and IS_ADJACENT_EAST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidBottomEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidBottomNorthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidNorthEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::East);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::East);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::North);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
+void Chunk::render() const {
+    if (not isBuilt()) return;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::North | Direction::East);
-    return isVoidAt(neighbor_voxel);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, mesh.ssbo_quads);
+    glDrawElements(GL_TRIANGLES, mesh.num_quads * 6, GL_UNSIGNED_INT, 0);
 }
 
-bool Chunk::isVoidBottomNorthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_NORTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::North);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_NORTH and IS_ADJACENT_WEST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North);
-        return isVoidBottomWestNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidBottomNorthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_NORTH and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidNorthWestNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::West);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_NORTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::West);
-        return isVoidNorthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::North);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
+bool Chunk::isChunkVisible(const std::array<glm::vec4, 6>& frustum_planes) const {
+    if (isEmpty() or not isBuilt()) return false;
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::North | Direction::West);
-    return isVoidAt(neighbor_voxel);
+    return bounding_box.isInFrustum(frustum_planes);
 }
 
-bool Chunk::isVoidBottomSouthEastNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_EAST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::East);
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_SOUTH and IS_ADJACENT_EAST) {
-        return true;
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidBottomEastNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::East);
-        return isVoidBottomSouthNeighbor(neighbor_voxel);
-    }
-
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidSouthEastNeighbor(neighbor_voxel);
-    }
+bool Chunk::isBuilt() const {
+    return is_built;
+}
 
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::East);
-        return isVoidBottomNeighbor(neighbor_voxel);
-    }
+bool Chunk::isDirty() const {
+    return is_dirty;
+}
 
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::East);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
+void Chunk::setDirty(const bool state) {
+    is_dirty = state;
+}
 
-    if (IS_ADJACENT_EAST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::South);
-        return isVoidEastNeighbor(neighbor_voxel);
-    }
+ChunkPersistence Chunk::getPersistence() const {
+    return persistence;
+}
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::South | Direction::East);
-    return isVoidAt(neighbor_voxel);
+void Chunk::setPersistence(const ChunkPersistence state) {
+    persistence = state;
+    if (ChunkPersistence::Snapshot == persistence) edits.clear();
 }
 
-bool Chunk::isVoidBottomSouthWestNeighbor(const LocalPosition voxel_origin) const {
-    LocalPosition neighbor_voxel = voxel_origin;
-    const bool IS_ADJACENT_SOUTH = isVoxelAdjacentToChunkInXAxis(voxel_origin, Direction::South);
-    const bool IS_ADJACENT_BOTTOM = isVoxelAdjacentToChunkInYAxis(voxel_origin, Direction::Bottom);
-    const bool IS_ADJACENT_WEST = isVoxelAdjacentToChunkInZAxis(voxel_origin, Direction::West);
+bool Chunk::isEmpty() const {
+    return std::all_of(sections.begin(), sections.end(), [](const chisel::ChunkSection& section) {
+        return chisel::SectionState::Empty == section.getState();
+    });
+}
 
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_SOUTH and IS_ADJACENT_WEST) {
-        return true;
-    }
+bool Chunk::isFull() const {
+    return std::all_of(sections.begin(), sections.end(), [](const chisel::ChunkSection& section) {
+        return chisel::SectionState::Uniform == section.getState();
+    });
+}
 
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South);
-        return isVoidBottomWestNeighbor(neighbor_voxel);
-    }
+void Chunk::setBuilt(const bool state) {
+    is_built = state;
+}
 
-    if (IS_ADJACENT_BOTTOM and IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::West);
-        return isVoidBottomSouthNeighbor(neighbor_voxel);
-    }
+chisel::types::VoxelID Chunk::getVoxelID(const LocalPosition local) const {
+    return sections.at(local.y / chisel::ChunkDataConstants::SECTION_HEIGHT).get(toSectionIndex(local));
+}
 
-    if (IS_ADJACENT_SOUTH and IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom);
-        return isVoidSouthWestNeighbor(neighbor_voxel);
-    }
+void Chunk::setVoxelIDAtPosition(const chisel::types::VoxelID voxel_id, const LocalPosition local) {
+    try {
+        applyVoxelID(voxel_id, local);
+        is_dirty = true;
 
-    if (IS_ADJACENT_BOTTOM) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::West);
-        return isVoidBottomNeighbor(neighbor_voxel);
+        if (ChunkPersistence::Delta == persistence) edits.insert_or_assign(Conversion::toIndex(local), voxel_id);
+    } catch (std::out_of_range& e) {
+        std::cerr << local.x << ' ' << local.y << ' ' << local.z << '\n';
+        std::cerr << e.what() << '\n';
     }
+}
 
-    if (IS_ADJACENT_SOUTH) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::West);
-        return isVoidSouthNeighbor(neighbor_voxel);
-    }
+void Chunk::applyVoxelID(const chisel::types::VoxelID voxel_id, const LocalPosition local) {
+    if (local.y >= chisel::ChunkDataConstants::CHUNK_HEIGHT) throw std::out_of_range("Chunk::setVoxelIDAtPosition above CHUNK_HEIGHT");
+    sections.at(local.y / chisel::ChunkDataConstants::SECTION_HEIGHT).set(toSectionIndex(local), voxel_id);
 
-    if (IS_ADJACENT_WEST) {
-        neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::South);
-        return isVoidWestNeighbor(neighbor_voxel);
-    }
+    ColumnMask& column = column_masks.at(local.x + chisel::ChunkDataConstants::CHUNK_SIZE * local.z);
+    const ColumnMask VOXEL_BIT = static_cast<ColumnMask>(1) << local.y;
+    column = chisel::AIR_ID == voxel_id ? column & ~VOXEL_BIT : column | VOXEL_BIT;
+}
 
-    neighbor_voxel += CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom | Direction::South | Direction::West);
-    return isVoidAt(neighbor_voxel);
+ColumnMask Chunk::getColumnMask(const unsigned x, const unsigned z) const {
+    return column_masks.at(x + chisel::ChunkDataConstants::CHUNK_SIZE * z);
 }
 
-void Chunk::fetchNeighbors(const ChunkNeighbors &neighbors) {
-    this->neighbors = neighbors;
+const std::array<ColumnMask, chisel::ChunkDataConstants::CHUNK_AREA>& Chunk::getColumnMasks() const {
+    return column_masks;
 }
 
 void Chunk::setPosition(const ChunkPosition position) {
     this->position = position;
 }
-
-void Chunk::preload() {
-    constexpr unsigned RESERVED_NUM_FACES = 8192;
-    mesh.vertices.reserve(RESERVED_NUM_FACES * 4);
-    mesh.indices.reserve(RESERVED_NUM_FACES * 6);
-}
@@ -7,7 +7,6 @@
 #include <algorithm>
 #include <ostream>
 #include <iostream>
-#include <algorithm>
 
 #include <glad/gl.h>
 #include <unordered_map>
@@ -19,7 +18,11 @@
 #include "proc_gen.hpp"
 #include "direction.hpp"
 #include "conversions.hpp"
+#include "byte_stream.hpp"
 #include "block_registry.hpp"
+#include "chunk_mesher.hpp"
+#include "chunk_section.hpp"
+#include "quad_index_buffer.hpp"
 
 class Chunk;
 using ChunkPtr = std::unique_ptr<Chunk>;
@@ -48,115 +51,95 @@ using ChunkPtr = std::unique_ptr<Chunk>;
     return 0 == local.y;
 }
 
-struct Vertex {
-    GLuint packed_data {};
-
-    Vertex() = default;
-    ~Vertex() = default;
-
-    Vertex(int vertex_index, const LocalPosition &voxel_origin, unsigned ao_id, Direction face_direction, chisel::types::VoxelID voxel_id);
-
-    Vertex(Vertex&& other) noexcept {
-        packed_data = other.packed_data;
-    }
+// Drawn with the shared quad index buffer bound, see quad_index_buffer.hpp
+struct ChunkMesh {
+    GLuint ssbo_quads {};
 
-    void appendBits(unsigned data, unsigned size);
+    // Only the GPU buffers are kept, the CPU side mesh is dropped once uploaded
+    GLsizei num_quads {};
 };
 
-struct ChunkMesh {
-    GLuint ssbo_vertices {}, ebo {}, vao {};
-
-    std::vector<Vertex> vertices {};
-    std::vector<GLuint> indices {};
+// How a chunk is saved, as its edits replayed over the generated terrain or as all of its voxels
+enum class ChunkPersistence : uint8_t {
+    Delta,
+    Snapshot
 };
 
-struct ChunkNeighbors {
-    const Chunk* north {};
-    const Chunk* south {};
-    const Chunk* east {};
-    const Chunk* west {};
+/*
+ * Everything a save keeps of a chunk, copied out of it so the chunk can be
+ * reset and reused right away while the copy is encoded on another thread.
+*/
+struct ChunkSaveData {
+    std::array<chisel::ChunkSection, chisel::ChunkDataConstants::NUM_SECTIONS> sections {};
+    std::vector<std::pair<VoxelIndex, chisel::types::VoxelID>> edits {};
+    ChunkPersistence persistence = ChunkPersistence::Delta;
 
-    const Chunk* north_east {};
-    const Chunk* north_west {};
-    const Chunk* south_east {};
-    const Chunk* south_west {};
+    void serialize(std::vector<uint8_t>& bytes) const;
 };
 
 class Chunk {
     ChunkMesh mesh;
     AABB bounding_box {};
     ChunkPosition position {};
-    ChunkNeighbors neighbors {};
 
-    std::array<chisel::types::VoxelID, chisel::ChunkDataConstants::CHUNK_VOLUME> voxel_ids {};
-    std::array<float, chisel::ChunkDataConstants::CHUNK_AREA> height_map {};
+    std::array<chisel::ChunkSection, chisel::ChunkDataConstants::NUM_SECTIONS> sections {};
+
+    // Bit y of column (x, z) is set when the voxel at (x, y, z) is solid
+    std::array<ColumnMask, chisel::ChunkDataConstants::CHUNK_AREA> column_masks {};
 
-    bool is_empty = true;
     bool is_built = false;
 
-    // kill me
-    [[nodiscard]] bool isVoidEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidNorthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidSouthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomNeighbor(LocalPosition) const;
-
-    [[nodiscard]] bool isVoidNorthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidNorthWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidSouthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidSouthWestNeighbor(LocalPosition) const;
-
-    [[nodiscard]] bool isVoidTopNorthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopSouthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopNorthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopNorthWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopSouthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidTopSouthWestNeighbor(LocalPosition) const;
-
-    [[nodiscard]] bool isVoidBottomNorthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomSouthNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomNorthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomNorthWestNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomSouthEastNeighbor(LocalPosition) const;
-    [[nodiscard]] bool isVoidBottomSouthWestNeighbor(LocalPosition) const;
-
-    [[nodiscard]] std::array<unsigned, 4> getVertexAO(Direction, LocalPosition) const;
+    // Voxels differ from what is saved, set by edits and by generation when every chunk is saved
+    bool is_dirty = false;
+
+    // Every voxel set since the chunk was generated, by index. Dropped once the chunk is kept as a snapshot
+    std::unordered_map<VoxelIndex, chisel::types::VoxelID> edits {};
+    ChunkPersistence persistence = ChunkPersistence::Delta;
 
     void setBuilt(bool);
-    void setEmpty(bool);
+    void assignRuns(const std::vector<chisel::VoxelRun>& runs);
+    void rebuildColumnMasks();
+    void applyVoxelID(chisel::types::VoxelID voxel_id, LocalPosition local);
+
+    [[nodiscard]] bool deserializeSnapshot(chisel::ByteReader&);
+    [[nodiscard]] bool deserializeDelta(chisel::ByteReader&);
 public:
     Chunk() = default;
     explicit Chunk(const ChunkPosition position) : position(position) {}
 
     ~Chunk() { destroyMesh(); }
 
-    void fetchNeighbors(const ChunkNeighbors &);
-
-    void preload();
-    void buildVoxels();
-    void buildMesh();
+    void buildVoxels(const HeightMap& height_map);
+    void buildDensityVoxels(const HeightMap& height_map, TerrainNoise& terrain_noise);
+    void uploadMesh(const ChunkMeshData &mesh_data);
 
     void destroyMesh();
     void resetVoxels();
 
     void render() const;
 
+    [[nodiscard]] ChunkSaveData getSaveData() const;
+    [[nodiscard]] bool deserialize(const uint8_t* bytes, size_t size);
+    void restore(ChunkSaveData&& save_data);
+    void replayEdits();
+
     void setPosition(ChunkPosition position);
+    void setDirty(bool);
+    void setPersistence(ChunkPersistence);
     void setVoxelIDAtPosition(chisel::types::VoxelID voxel_id, LocalPosition local);
 
     [[nodiscard]] bool isBuilt() const;
+    [[nodiscard]] bool isDirty() const;
+    [[nodiscard]] ChunkPersistence getPersistence() const;
     [[nodiscard]] bool isEmpty() const;
-    [[nodiscard]] bool isVoidAt(LocalPosition local) const;
+    [[nodiscard]] bool isFull() const;
     [[nodiscard]] bool isChunkVisible(const std::array<glm::vec4, 6>& frustum_planes) const;
 
     [[nodiscard]] chisel::types::VoxelID getVoxelID(LocalPosition local) const;
-
-    [[nodiscard]] float getNoise(int x, int z) const;
+    [[nodiscard]] ColumnMask getColumnMask(unsigned x, unsigned z) const;
+    [[nodiscard]] const std::array<ColumnMask, chisel::ChunkDataConstants::CHUNK_AREA>& getColumnMasks() const;
+    [[nodiscard]] size_t getNumQuads() const;
+    [[nodiscard]] size_t getVoxelMemoryUsage() const;
 };
 
 #endif
\ No newline at end of file
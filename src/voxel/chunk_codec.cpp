@@ -0,0 +1,111 @@
+#include "chunk_codec.hpp"
+
+#include <array>
+#include <vector>
+#include <algorithm>
+
+#include "chunk_snapshot.hpp"
+
+using namespace chisel::ChunkDataConstants;
+
+static_assert(CHUNK_VOLUME <= 1 << 16, "A run length and a palette index must fit together in a 32 bit varint");
+static_assert(CHUNK_HEIGHT <= 32, "A chunk column must fit in a 32 bit change mask");
+
+// Number of bits taken by the palette index in a run
+unsigned getIndexBits(const size_t palette_size) {
+    unsigned bits = 0;
+    while ((static_cast<size_t>(1) << bits) < palette_size) bits++;
+    return bits;
+}
+
+// Runs are found without walking the columns: bit y of a column's mask is set where the voxel
+// differs from the one below it, comparing whole layers at a time
+void chisel::ChunkCodec::encode(const types::VoxelID* voxel_ids, ByteWriter& writer) {
+    std::array<uint32_t, CHUNK_AREA> change_masks {};
+
+    for (size_t y = 1; y < CHUNK_HEIGHT; y++) {
+        const types::VoxelID* layer_ids = voxel_ids + y * CHUNK_AREA;
+        const types::VoxelID* layer_below_ids = layer_ids - CHUNK_AREA;
+
+        for (size_t column = 0; column < CHUNK_AREA; column++) {
+            change_masks[column] |= static_cast<uint32_t>(layer_ids[column] != layer_below_ids[column]) << y;
+        }
+    }
+
+    std::vector<chisel::VoxelRun> runs {};
+    chisel::VoxelRun run { voxel_ids[0], 0 };
+    size_t run_start = 0;
+
+    for (size_t column = 0; column < CHUNK_AREA; column++) {
+        // A run carries on from the top of the previous column unless the bottom voxel differs
+        uint32_t change_mask = change_masks[column] | static_cast<uint32_t>(voxel_ids[column] != run.voxel_id);
+
+        while (0 != change_mask) {
+            const size_t Y = countTrailingZeros(change_mask);
+            change_mask &= change_mask - 1;
+
+            const size_t RUN_END = column * CHUNK_HEIGHT + Y;
+            run.length = static_cast<uint32_t>(RUN_END - run_start);
+            runs.push_back(run);
+
+            run.voxel_id = voxel_ids[Y * CHUNK_AREA + column];
+            run_start = RUN_END;
+        }
+    }
+
+    run.length = static_cast<uint32_t>(CHUNK_VOLUME - run_start);
+    runs.push_back(run);
+
+    // Only looked up once per run, chunks hold a handful of IDs
+    std::vector<types::VoxelID> palette {};
+    std::vector<uint32_t> palette_indices(runs.size());
+
+    for (size_t i = 0; i < runs.size(); i++) {
+        auto it = std::find(palette.begin(), palette.end(), runs[i].voxel_id);
+        if (palette.end() == it) it = palette.insert(palette.end(), runs[i].voxel_id);
+
+        palette_indices[i] = static_cast<uint32_t>(it - palette.begin());
+    }
+
+    writer.writeVarint(static_cast<uint32_t>(palette.size()));
+    for (const types::VoxelID voxel_id : palette) writer.writeVarint(voxel_id);
+
+    const unsigned INDEX_BITS = getIndexBits(palette.size());
+
+    for (size_t i = 0; i < runs.size(); i++) {
+        writer.writeVarint((runs[i].length - 1) << INDEX_BITS | palette_indices[i]);
+    }
+}
+
+bool chisel::ChunkCodec::decode(ByteReader& reader, std::vector<VoxelRun>& runs) {
+    uint32_t palette_size = 0;
+    if (not reader.readVarint(palette_size) or 0 == palette_size or palette_size > CHUNK_VOLUME) return false;
+
+    std::vector<types::VoxelID> palette(palette_size);
+
+    for (auto& voxel_id : palette) {
+        uint32_t saved_id = 0;
+        if (not reader.readVarint(saved_id) or saved_id > UINT16_MAX) return false;
+
+        voxel_id = static_cast<types::VoxelID>(saved_id);
+    }
+
+    const unsigned INDEX_BITS = getIndexBits(palette.size());
+    const uint32_t INDEX_MASK = (static_cast<uint32_t>(1) << INDEX_BITS) - 1;
+
+    runs.clear();
+
+    for (size_t num_decoded = 0; num_decoded < CHUNK_VOLUME;) {
+        uint32_t token = 0;
+        if (not reader.readVarint(token)) return false;
+
+        const uint32_t PALETTE_INDEX = token & INDEX_MASK;
+        const size_t LENGTH = (token >> INDEX_BITS) + 1;
+        if (PALETTE_INDEX >= palette_size or LENGTH > CHUNK_VOLUME - num_decoded) return false;
+
+        runs.push_back({ palette[PALETTE_INDEX], static_cast<uint32_t>(LENGTH) });
+        num_decoded += LENGTH;
+    }
+
+    return true;
+}
@@ -0,0 +1,30 @@
+#ifndef CHUNK_CODEC_HPP
+#define CHUNK_CODEC_HPP
+
+#include "byte_stream.hpp"
+#include "palette_storage.hpp"
+#include "block_registry.hpp"
+#include "engine_constants.hpp"
+
+/*
+ * Compact encoding of all the voxels of a chunk, used wherever a chunk leaves
+ * memory: region files today, the network later.
+ *
+ * Voxels are walked column by column, bottom to top, in the order of the
+ * column masks. Generated columns are a few long runs of strata under air,
+ * so the walk is stored as runs, each one a varint packing the run length
+ * with an index into a palette of the IDs in the chunk. A run carries on
+ * into the next column when the ID does not change.
+ *
+ * Layout: varint palette size, varint palette IDs, then runs until every
+ * voxel of the chunk is covered.
+*/
+namespace chisel::ChunkCodec {
+    // voxel_ids holds CHUNK_VOLUME IDs laid out by VoxelIndex
+    void encode(const types::VoxelID* voxel_ids, ByteWriter&);
+
+    // Runs in column order covering all CHUNK_VOLUME voxels, false when the bytes are not a valid encoding
+    [[nodiscard]] bool decode(ByteReader&, std::vector<VoxelRun>& runs);
+}
+
+#endif
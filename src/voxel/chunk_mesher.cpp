@@ -0,0 +1,274 @@
+#include "chunk_mesher.hpp"
+
+constexpr std::array MESHED_FACES = {
+    Direction::Top, Direction::Bottom, Direction::North, Direction::South, Direction::East, Direction::West
+};
+
+struct FaceAxes {
+    int normal, u, v;
+};
+
+// Axis the face is sliced along, and the two in-plane axes quads are merged over, as { normal, u, v }
+const std::unordered_map<Direction, FaceAxes> GREEDY_FACE_AXES {
+    { Direction::Top,    { 1, 0, 2 } },
+    { Direction::Bottom, { 1, 0, 2 } },
+    { Direction::North,  { 0, 2, 1 } },
+    { Direction::South,  { 0, 2, 1 } },
+    { Direction::East,   { 2, 0, 1 } },
+    { Direction::West,   { 2, 0, 1 } },
+};
+
+// Neighbors sampled around a face for AO, corner i shades with neighbors 2i, 2i+1 and 2i+2
+constexpr std::array<std::array<std::array<int, 3>, 8>, 6> FACE_AO_NEIGHBORS {{
+    {{ {-1,  1,  0}, {-1,  1, -1}, { 0,  1, -1}, { 1,  1, -1}, { 1,  1,  0}, { 1,  1,  1}, { 0,  1,  1}, {-1,  1,  1} }}, // Top
+    {{ {-1, -1,  0}, {-1, -1, -1}, { 0, -1, -1}, { 1, -1, -1}, { 1, -1,  0}, { 1, -1,  1}, { 0, -1,  1}, {-1, -1,  1} }}, // Bottom
+    {{ { 1, -1,  0}, { 1, -1, -1}, { 1,  0, -1}, { 1,  1, -1}, { 1,  1,  0}, { 1,  1,  1}, { 1,  0,  1}, { 1, -1,  1} }}, // North
+    {{ {-1, -1,  0}, {-1, -1, -1}, {-1,  0, -1}, {-1,  1, -1}, {-1,  1,  0}, {-1,  1,  1}, {-1,  0,  1}, {-1, -1,  1} }}, // South
+    {{ { 0, -1,  1}, {-1, -1,  1}, {-1,  0,  1}, {-1,  1,  1}, { 0,  1,  1}, { 1,  1,  1}, { 1,  0,  1}, { 1, -1,  1} }}, // East
+    {{ { 0, -1, -1}, {-1, -1, -1}, {-1,  0, -1}, {-1,  1, -1}, { 0,  1, -1}, { 1,  1, -1}, { 1,  0, -1}, { 1, -1, -1} }}, // West
+}};
+
+// FACE_AO_NEIGHBORS flattened into offsets within the snapshot's padded volume
+constexpr std::array<std::array<int, 8>, 6> FACE_AO_OFFSETS = [] {
+    std::array<std::array<int, 8>, 6> offsets {};
+
+    for (size_t face_id = 0; face_id < offsets.size(); face_id++) {
+        for (size_t i = 0; i < offsets[face_id].size(); i++) {
+            const auto& [dx, dy, dz] = FACE_AO_NEIGHBORS[face_id][i];
+            offsets[face_id][i] = dx * ChunkSnapshot::STRIDE_X + dy * ChunkSnapshot::STRIDE_Y + dz * ChunkSnapshot::STRIDE_Z;
+        }
+    }
+
+    return offsets;
+}();
+
+unsigned getAxisExtent(const int axis) {
+    return 1 == axis ? chisel::ChunkDataConstants::CHUNK_HEIGHT : chisel::ChunkDataConstants::CHUNK_SIZE;
+}
+
+unsigned toPaddedIndex(const LocalPosition voxel_origin) {
+    return ChunkSnapshot::toPaddedIndex(static_cast<int>(voxel_origin.x), static_cast<int>(voxel_origin.y), static_cast<int>(voxel_origin.z));
+}
+
+// Bit y is set when the voxel at height y in the column has an exposed face in the given direction
+ColumnMask getFaceMask(const ChunkSnapshot &snapshot, const Direction face, const int x, const int z) {
+    const ColumnMask PADDED = snapshot.getPaddedColumnMask(x, z);
+    const ColumnMask SOLID = snapshot.getColumnMask(x, z);
+
+    switch (face) {
+        case Direction::Top:    return SOLID & ~(PADDED >> 2);
+        case Direction::Bottom: return SOLID & ~PADDED;
+        case Direction::North:  return SOLID & ~snapshot.getColumnMask(x + 1, z);
+        case Direction::South:  return SOLID & ~snapshot.getColumnMask(x - 1, z);
+        case Direction::East:   return SOLID & ~snapshot.getColumnMask(x, z + 1);
+        case Direction::West:   return SOLID & ~snapshot.getColumnMask(x, z - 1);
+        default:                return 0;
+    }
+}
+
+std::array<unsigned, 4> getVertexAO(const ChunkSnapshot &snapshot, const unsigned face_id, const unsigned padded_index) {
+    std::array<unsigned, 8> is_void {};
+
+    for (size_t i = 0; i < is_void.size(); i++) {
+        const auto NEIGHBOR_INDEX = static_cast<unsigned>(static_cast<int>(padded_index) + FACE_AO_OFFSETS[face_id][i]);
+        is_void[i] = chisel::AIR_ID == snapshot.getVoxelID(NEIGHBOR_INDEX);
+    }
+
+    return {
+        is_void[0] + is_void[1] + is_void[2],
+        is_void[2] + is_void[3] + is_void[4],
+        is_void[4] + is_void[5] + is_void[6],
+        is_void[6] + is_void[7] + is_void[0]
+    };
+}
+
+// Face key layout: [ voxel id : 16 | ao 3 : 2 | ao 2 : 2 | ao 1 : 2 | ao 0 : 2 ], 0 means no visible face
+uint32_t packFaceKey(const chisel::types::VoxelID voxel_id, const std::array<unsigned, 4> &AO) {
+    return static_cast<uint32_t>(voxel_id) << 8 | AO.at(3) << 6 | AO.at(2) << 4 | AO.at(1) << 2 | AO.at(0);
+}
+
+chisel::types::VoxelID unpackFaceKeyVoxelID(const uint32_t key) {
+    return static_cast<chisel::types::VoxelID>(key >> 8);
+}
+
+std::array<unsigned, 4> unpackFaceKeyAO(const uint32_t key) {
+    return { key & 0b11u, key >> 2 & 0b11u, key >> 4 & 0b11u, key >> 6 & 0b11u };
+}
+
+// Only faces with the same AO on every corner are merged, otherwise the AO gradient would be stretched over the quad
+bool isFaceKeyMergeable(const uint32_t key) {
+    const auto AO = unpackFaceKeyAO(key);
+    return AO.at(0) == AO.at(1) and AO.at(1) == AO.at(2) and AO.at(2) == AO.at(3);
+}
+
+void appendBits(GLuint &packed_data, const unsigned data, const unsigned size) {
+    packed_data <<= size;
+    packed_data |= data;
+}
+
+Quad::Quad(const LocalPosition &voxel_origin, const LocalPosition &quad_size, const std::array<unsigned, 4> &AO, const Direction face_direction, const chisel::types::VoxelID voxel_id) {
+    using namespace chisel::ChunkDataConstants;
+
+    appendBits(packed_face, voxel_origin.x, X_SIZE);
+    appendBits(packed_face, voxel_origin.y, Y_SIZE);
+    appendBits(packed_face, voxel_origin.z, Z_SIZE);
+    appendBits(packed_face, FACE_DIRECTION_TO_ID.at(face_direction), FACE_ID_SIZE);
+    appendBits(packed_face, +voxel_id, VOXEL_ID_SIZE);
+
+    appendBits(packed_shape, AO.at(3), AO_ID_SIZE);
+    appendBits(packed_shape, AO.at(2), AO_ID_SIZE);
+    appendBits(packed_shape, AO.at(1), AO_ID_SIZE);
+    appendBits(packed_shape, AO.at(0), AO_ID_SIZE);
+    appendBits(packed_shape, quad_size.x - 1, X_SIZE);
+    appendBits(packed_shape, quad_size.y - 1, Y_SIZE);
+    appendBits(packed_shape, quad_size.z - 1, Z_SIZE);
+}
+
+void emitQuad(ChunkMeshData &mesh_data, const Direction face, const LocalPosition &voxel_origin, const LocalPosition &quad_size, const std::array<unsigned, 4> &AO, const chisel::types::VoxelID voxel_id) {
+    mesh_data.quads.emplace_back(voxel_origin, quad_size, AO, face, voxel_id);
+
+    mesh_data.bounding_box.updateWithQuad(face, voxel_origin, quad_size);
+}
+
+void buildNaiveMesh(const ChunkSnapshot &snapshot, ChunkMeshData &mesh_data) {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+
+    for (unsigned z = 0; z < CHUNK_SIZE; z++) {
+        for (unsigned x = 0; x < CHUNK_SIZE; x++) {
+            for (unsigned face_id = 0; face_id < MESHED_FACES.size(); face_id++) {
+                const Direction face = MESHED_FACES[face_id];
+                ColumnMask face_mask = getFaceMask(snapshot, face, static_cast<int>(x), static_cast<int>(z));
+
+                while (0 != face_mask) {
+                    const LocalPosition voxel_origin { x, countTrailingZeros(face_mask), z };
+                    const unsigned PADDED_INDEX = toPaddedIndex(voxel_origin);
+                    face_mask &= face_mask - 1;
+
+                    emitQuad(mesh_data, face, voxel_origin, LocalPosition(1), getVertexAO(snapshot, face_id, PADDED_INDEX), snapshot.getVoxelID(PADDED_INDEX));
+                }
+            }
+        }
+    }
+}
+
+// For slices along y, every height when the slice has a face and none otherwise. For vertical slices,
+// the heights at which any column of the slice has a face
+ColumnMask getSliceFaceMask(const std::array<ColumnMask, chisel::ChunkDataConstants::CHUNK_AREA> &face_masks, const ColumnMask any_face, const int normal, const unsigned n) {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+
+    if (1 == normal) return 0 != (any_face >> n & 1) ? ~static_cast<ColumnMask>(0) : 0;
+
+    ColumnMask slice_faces = 0;
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        slice_faces |= face_masks[0 == normal ? n + CHUNK_SIZE * i : i + CHUNK_SIZE * n];
+    }
+
+    return slice_faces;
+}
+
+void buildGreedyMesh(const ChunkSnapshot &snapshot, ChunkMeshData &mesh_data) {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+    using chisel::ChunkDataConstants::CHUNK_HEIGHT;
+    using chisel::ChunkDataConstants::CHUNK_AREA;
+
+    std::array<uint32_t, CHUNK_SIZE * CHUNK_HEIGHT> face_keys {};
+    std::array<ColumnMask, CHUNK_AREA> face_masks {};
+
+    for (unsigned face_id = 0; face_id < MESHED_FACES.size(); face_id++) {
+        const Direction face = MESHED_FACES[face_id];
+        const auto [N_AXIS, U_AXIS, V_AXIS] = GREEDY_FACE_AXES.at(face);
+        const unsigned N_SIZE = getAxisExtent(N_AXIS);
+        const unsigned U_SIZE = getAxisExtent(U_AXIS);
+        const unsigned V_SIZE = getAxisExtent(V_AXIS);
+
+        ColumnMask any_face = 0;
+        for (unsigned z = 0; z < CHUNK_SIZE; z++) {
+            for (unsigned x = 0; x < CHUNK_SIZE; x++) {
+                face_masks[x + CHUNK_SIZE * z] = getFaceMask(snapshot, face, static_cast<int>(x), static_cast<int>(z));
+                any_face |= face_masks[x + CHUNK_SIZE * z];
+            }
+        }
+
+        if (0 == any_face) continue;
+
+        for (unsigned n = 0; n < N_SIZE; n++) {
+            // Heights holding at least one face of this slice, layers that are empty or buried inside
+            // a solid section have none and are skipped without looking at their voxels
+            const ColumnMask SLICE_FACES = getSliceFaceMask(face_masks, any_face, N_AXIS, n);
+            if (0 == SLICE_FACES) continue;
+
+            LocalPosition voxel_origin {};
+            voxel_origin[N_AXIS] = n;
+
+            for (unsigned v = 0; v < V_SIZE; v++) {
+                if (1 == V_AXIS and 0 == (SLICE_FACES >> v & 1)) {
+                    const auto ROW_BEGIN = face_keys.begin() + v * U_SIZE;
+                    std::fill(ROW_BEGIN, ROW_BEGIN + U_SIZE, 0);
+                    continue;
+                }
+
+                for (unsigned u = 0; u < U_SIZE; u++) {
+                    voxel_origin[U_AXIS] = u;
+                    voxel_origin[V_AXIS] = v;
+
+                    const bool HAS_FACE = 0 != (face_masks[voxel_origin.x + CHUNK_SIZE * voxel_origin.z] >> voxel_origin.y & 1);
+                    if (not HAS_FACE) {
+                        face_keys[v * U_SIZE + u] = 0;
+                        continue;
+                    }
+
+                    const unsigned PADDED_INDEX = toPaddedIndex(voxel_origin);
+                    face_keys[v * U_SIZE + u] = packFaceKey(snapshot.getVoxelID(PADDED_INDEX), getVertexAO(snapshot, face_id, PADDED_INDEX));
+                }
+            }
+
+            for (unsigned v = 0; v < V_SIZE; v++) {
+                if (1 == V_AXIS and 0 == (SLICE_FACES >> v & 1)) continue;
+
+                for (unsigned u = 0; u < U_SIZE; u++) {
+                    const uint32_t KEY = face_keys[v * U_SIZE + u];
+                    if (0 == KEY) continue;
+
+                    unsigned width = 1;
+                    unsigned height = 1;
+
+                    if (isFaceKeyMergeable(KEY)) {
+                        while (u + width < U_SIZE and KEY == face_keys[v * U_SIZE + u + width]) {
+                            width++;
+                        }
+
+                        while (v + height < V_SIZE) {
+                            const auto ROW_BEGIN = face_keys.begin() + (v + height) * U_SIZE + u;
+                            if (not std::all_of(ROW_BEGIN, ROW_BEGIN + width, [KEY](const uint32_t key) { return KEY == key; })) break;
+                            height++;
+                        }
+                    }
+
+                    for (unsigned dv = 0; dv < height; dv++) {
+                        const auto ROW_BEGIN = face_keys.begin() + (v + dv) * U_SIZE + u;
+                        std::fill(ROW_BEGIN, ROW_BEGIN + width, 0);
+                    }
+
+                    LocalPosition quad_size { 1 };
+                    quad_size[U_AXIS] = width;
+                    quad_size[V_AXIS] = height;
+
+                    voxel_origin[U_AXIS] = u;
+                    voxel_origin[V_AXIS] = v;
+                    emitQuad(mesh_data, face, voxel_origin, quad_size, unpackFaceKeyAO(KEY), unpackFaceKeyVoxelID(KEY));
+                }
+            }
+        }
+    }
+}
+
+void buildMeshData(const ChunkSnapshot &snapshot, const MeshingMode mode, ChunkMeshData &mesh_data) {
+    mesh_data.quads.clear();
+    mesh_data.bounding_box.reset();
+
+    if (MeshingMode::Greedy == mode) {
+        buildGreedyMesh(snapshot, mesh_data);
+    } else {
+        buildNaiveMesh(snapshot, mesh_data);
+    }
+}
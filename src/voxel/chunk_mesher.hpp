@@ -0,0 +1,45 @@
+#ifndef CHUNK_MESHER_HPP
+#define CHUNK_MESHER_HPP
+
+#include <array>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "aabb.hpp"
+#include "direction.hpp"
+#include "conversions.hpp"
+#include "block_registry.hpp"
+#include "chunk_snapshot.hpp"
+
+/*
+ * One quad per exposed face, chunk.vert expands it into four corners from gl_VertexID.
+ *
+ * packed_face:  [ x | y | z | face id | voxel id ]
+ * packed_shape: [ ao 3 | ao 2 | ao 1 | ao 0 | size x | size y | size z ]
+ *
+ * Sizes are stored minus one, so a quad spanning a whole chunk fits the same bits as a position.
+*/
+struct Quad {
+    GLuint packed_face {};
+    GLuint packed_shape {};
+
+    Quad() = default;
+    Quad(const LocalPosition &voxel_origin, const LocalPosition &quad_size, const std::array<unsigned, 4> &AO, Direction face_direction, chisel::types::VoxelID voxel_id);
+};
+
+enum class MeshingMode : unsigned {
+    Naive,  // One quad per exposed voxel face
+    Greedy  // Coplanar faces with the same voxel ID and AO are merged into larger quads
+};
+
+// CPU side output of the mesher, each quad is drawn as six indices of the shared quad index buffer.
+// The bounding box is in chunk local space
+struct ChunkMeshData {
+    std::vector<Quad> quads {};
+    AABB bounding_box {};
+};
+
+void buildMeshData(const ChunkSnapshot &snapshot, MeshingMode mode, ChunkMeshData &mesh_data);
+
+#endif
@@ -1,30 +1,89 @@
 #include "chunk_pool.hpp"
 
-constexpr unsigned EXTRA_RESERVED = 0;
 constexpr unsigned WORLD_SIZE = 2 * chisel::EngineConstants::LOAD_DISTANCE + 1;
-constexpr unsigned POOL_RESERVED_SIZE = WORLD_SIZE * WORLD_SIZE + EXTRA_RESERVED;
+constexpr unsigned WORLD_HEIGHT = 2 * chisel::EngineConstants::VERTICAL_LOAD_DISTANCE + 1;
+constexpr unsigned POOL_RESERVED_SIZE = WORLD_SIZE * WORLD_SIZE * WORLD_HEIGHT;
 
-chisel::ChunkPool::ChunkPool() {
-    chunk_pool.reserve(POOL_RESERVED_SIZE+1);
-    used_chunk_ids.reserve(POOL_RESERVED_SIZE+1);
+// Chunks outside the view frustum are scheduled as if they were this many times farther away
+constexpr float OUT_OF_VIEW_DISTANCE_FACTOR = 4.0f;
 
-    chunk_pool.emplace_back(nullptr);
-    for (size_t ID = 1; ID <= POOL_RESERVED_SIZE; ID++) {
-        auto p_chunk = std::make_unique<Chunk>();
-        p_chunk->preload();
+// Weight of the newest sample in the running per-chunk costs
+constexpr float COST_SMOOTHING = 0.1f;
+
+using Clock = std::chrono::steady_clock;
+
+float getElapsedMs(const Clock::time_point since) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - since).count();
+}
+
+void updateAverageCost(float &average_ms, const float sample_ms) {
+    average_ms += (sample_ms - average_ms) * COST_SMOOTHING;
+}
+
+// One thread per core is left to the main thread, the terrain and mesh workers share the others
+unsigned getNumWorkerThreads() {
+    const unsigned NUM_THREADS = std::thread::hardware_concurrency();
+    return NUM_THREADS > 1 ? NUM_THREADS - 1 : 1;
+}
+
+// Both pools need a worker, with a single worker thread they share its core
+unsigned getNumTerrainWorkers() {
+    const unsigned NUM_WORKERS = getNumWorkerThreads();
+    if (NUM_WORKERS < 2) return 1;
+
+    const auto NUM_TERRAIN_WORKERS = static_cast<unsigned>(static_cast<float>(NUM_WORKERS) * chisel::EngineConstants::TERRAIN_WORKER_SHARE + 0.5f);
+    return std::clamp(NUM_TERRAIN_WORKERS, 1u, NUM_WORKERS - 1);
+}
+
+unsigned getNumMeshWorkers() {
+    const unsigned NUM_WORKERS = getNumWorkerThreads();
+    return NUM_WORKERS < 2 ? 1 : NUM_WORKERS - getNumTerrainWorkers();
+}
+
+chisel::ChunkPool::ChunkPool() :
+    mesh_workers(getNumMeshWorkers()),
+    region_store(std::string(EngineConstants::WORLD_SAVE_DIRECTORY)),
+    terrain_workers(getNumTerrainWorkers(), region_store) {
+    // Chunks recycled while being generated only come back once their job is done
+    const size_t NUM_IN_FLIGHT = terrain_workers.getNumWorkers() * EngineConstants::TERRAIN_JOBS_IN_FLIGHT_PER_WORKER;
+    const size_t POOL_SIZE = POOL_RESERVED_SIZE + NUM_IN_FLIGHT;
 
-        chunk_pool.emplace_back(std::move(p_chunk));
+    chunk_pool.reserve(POOL_SIZE+1);
+    chunk_grid.resize(WORLD_SIZE * WORLD_SIZE * WORLD_HEIGHT);
+
+    chunk_pool.emplace_back(nullptr);
+    for (size_t ID = 1; ID <= POOL_SIZE; ID++) {
+        chunk_pool.emplace_back(std::make_unique<Chunk>());
         allocated_chunks.push(ID);
     }
 }
 
+size_t chisel::ChunkPool::toGridIndex(const ChunkPosition position) {
+    constexpr int SIZE = static_cast<int>(WORLD_SIZE);
+    constexpr int HEIGHT = static_cast<int>(WORLD_HEIGHT);
+    const int x = (position.x % SIZE + SIZE) % SIZE;
+    const int y = (position.y % HEIGHT + HEIGHT) % HEIGHT;
+    const int z = (position.z % SIZE + SIZE) % SIZE;
+
+    return static_cast<size_t>(x + SIZE * z + SIZE * SIZE * y);
+}
+
 chisel::ChunkID chisel::ChunkPool::getUsedChunkID(const ChunkPosition position) const {
-    if (not isPositionUsed(position)) return NULL_CHUNK_ID;
-    return used_chunk_ids.at(position);
+    const ChunkSlot& slot = chunk_grid[toGridIndex(position)];
+    return slot.position == position ? slot.id : NULL_CHUNK_ID;
+}
+
+Chunk* chisel::ChunkPool::getUsedChunk(const ChunkPosition position) const {
+    const auto ID = getUsedChunkID(position);
+    return ID != NULL_CHUNK_ID ? chunk_pool[ID].get() : nullptr;
 }
 
 void chisel::ChunkPool::use(const ChunkPosition position) {
-    if (isPositionUsed(position)) return;
+    ChunkSlot& slot = chunk_grid[toGridIndex(position)];
+    if (slot.id != NULL_CHUNK_ID) {
+        if (slot.position == position) return;
+        recycle(slot.position);
+    }
 
     if (allocated_chunks.empty()) {
         std::cerr << "WARNING :: Ran out of unused chunk!" << '\n';
@@ -34,146 +93,311 @@ void chisel::ChunkPool::use(const ChunkPosition position) {
     const ChunkID ID = allocated_chunks.front();
     allocated_chunks.pop();
 
-    used_chunk_ids.emplace(position, ID);
+    slot = { position, ID };
     chunk_pool.at(ID)->setPosition(position);
-    chunk_pool.at(ID)->buildVoxels();
+    terrain_workers.submit({ ID, position, std::move(chunk_pool.at(ID)) });
 }
 
 void chisel::ChunkPool::recycle(const ChunkPosition position) {
-    if (not isPositionUsed(position)) return;
-    const ChunkID ID = used_chunk_ids.at(position);
+    const ChunkID ID = getUsedChunkID(position);
+    if (ID == NULL_CHUNK_ID) return;
 
-    chunk_pool.at(ID)->destroyMesh();
-    chunk_pool.at(ID)->resetVoxels();
+    pending_meshes.erase(position);
+    chunk_grid[toGridIndex(position)].id = NULL_CHUNK_ID;
 
+    // Still owned by a terrain job, collectGeneratedChunks frees it once it is back
+    if (nullptr == chunk_pool.at(ID)) return;
+
+    Chunk& chunk = *chunk_pool.at(ID);
+    if (chunk.isDirty()) region_store.save(position, chunk);
+
+    chunk.destroyMesh();
+    chunk.resetVoxels();
     allocated_chunks.emplace(ID);
-    used_chunk_ids.erase(position);
+}
+
+// Chunks still loaded when the world is closed are only saved here
+void chisel::ChunkPool::saveDirtyChunks() {
+    for (auto const& [position, ID] : chunk_grid) {
+        if (ID == NULL_CHUNK_ID or nullptr == chunk_pool[ID] or not chunk_pool[ID]->isDirty()) continue;
+
+        region_store.save(position, *chunk_pool[ID]);
+        chunk_pool[ID]->setDirty(false);
+    }
+
+    region_store.flush();
+}
+
+bool chisel::ChunkPool::canUse() const {
+    return terrain_workers.getNumJobsInFlight() < terrain_workers.getNumWorkers() * EngineConstants::TERRAIN_JOBS_IN_FLIGHT_PER_WORKER;
+}
+
+// Chunks recycled while they were generated go back to the free list, the others are queued for meshing
+void chisel::ChunkPool::collectGeneratedChunks() {
+    TerrainResult result {};
+
+    while (terrain_workers.tryPopResult(result)) {
+        const ChunkID ID = result.chunk_id;
+        chunk_pool.at(ID) = std::move(result.chunk);
+
+        if (getUsedChunkID(result.position) != ID) {
+            chunk_pool.at(ID)->resetVoxels();
+            allocated_chunks.emplace(ID);
+            continue;
+        }
+
+        enqueueForBuilding(result.position);
+
+        // Every neighbor samples this chunk for its border faces and ambient occlusion
+        for (auto const& [_, offset] : CHUNK_NEIGHBORS_DIRECTION) {
+            const ChunkPosition neighbor = result.position + offset;
+            if (not isBuilt(neighbor) and not isMeshPending(neighbor)) continue;
+
+            enqueueForRebuilding(neighbor);
+        }
+    }
 }
 
 bool chisel::ChunkPool::isPositionUsed(const ChunkPosition position) const {
-    return used_chunk_ids.count(position) != 0;
+    return getUsedChunkID(position) != NULL_CHUNK_ID;
+}
+
+const Chunk* chisel::ChunkPool::getLoadedChunk(const ChunkPosition position) const {
+    return getUsedChunk(position);
 }
 
 void chisel::ChunkPool::enqueueForBuilding(const ChunkPosition position) {
     if (not isPositionUsed(position)) return;
     const auto [_, is_inserted] = chunks_to_build.emplace(position);
     if (not is_inserted) return;
-    build_queue.emplace(position);
+    build_queue.emplace_back(position);
 }
 
 void chisel::ChunkPool::enqueueForRebuilding(const ChunkPosition position) {
     if (not isPositionUsed(position)) return;
     const auto [_, is_inserted] = chunks_to_rebuild.emplace(position);
     if (not is_inserted) return;
-    rebuild_queue.emplace(position);
+    rebuild_queue.emplace_back(position);
 }
 
-void chisel::ChunkPool::buildQueuedChunks() {
-    if (build_queue.empty()) return;
-    unsigned num_chunks = EngineConstants::CHUNKS_TO_BUILD_PER_FRAME;
+void chisel::ChunkPool::enqueueForEditRebuilding(const ChunkPosition position) {
+    if (not isPositionUsed(position)) return;
+    edited_chunks.emplace(position);
+}
 
-    while (num_chunks != 0 and not build_queue.empty()) {
-        const auto position = build_queue.front();
-        chunks_to_build.erase(position);
-        build_queue.pop();
+void chisel::ChunkPool::setViewpoint(const glm::vec3 position, const std::array<glm::vec4, 6> &frustum_planes) {
+    viewpoint_position = position;
+    viewpoint_frustum_planes = frustum_planes;
+}
+
+// Streaming work stops once the budget is spent, the first item of each kind always goes through so nothing starves
+void chisel::ChunkPool::processQueuedChunks(const float budget_ms) {
+    frame_begin = Clock::now();
+    frame_budget_ms = budget_ms;
 
-        if (not isPositionUsed(position)) continue;
-        build(position);
-        num_chunks--;
+    for (const auto& position : edited_chunks) {
+        submitMeshJob(position, true);
     }
+    edited_chunks.clear();
+
+    collectGeneratedChunks();
+    uploadMeshedChunks();
+    submitPrioritizedMeshJobs(rebuild_queue, chunks_to_rebuild);
+    submitPrioritizedMeshJobs(build_queue, chunks_to_build);
 }
 
-void chisel::ChunkPool::rebuildQueuedChunks() {
-    if (rebuild_queue.empty()) return;
-    unsigned num_chunks = EngineConstants::CHUNKS_TO_REBUILD_PER_FRAME;
+bool chisel::ChunkPool::hasBudgetFor(const float average_cost_ms) const {
+    return getElapsedMs(frame_begin) + average_cost_ms <= frame_budget_ms;
+}
+
+// Priorities are recomputed from the current viewpoint on every call, so turning or moving reorders what is left
+void chisel::ChunkPool::submitPrioritizedMeshJobs(std::vector<ChunkPosition> &queue, std::unordered_set<ChunkPosition> &queued_chunks) {
+    if (queue.empty() or not canSubmitMeshJob()) return;
 
-    while (num_chunks != 0 and not rebuild_queue.empty()) {
-        const auto position = rebuild_queue.front();
-        chunks_to_rebuild.erase(position);
-        rebuild_queue.pop();
+    prioritized_chunks.clear();
+    for (const auto& position : queue) {
+        if (not isPositionUsed(position)) {
+            queued_chunks.erase(position);
+            continue;
+        }
 
-        if (not isPositionUsed(position)) continue;
-        rebuild(position);
-        num_chunks--;
+        prioritized_chunks.emplace_back(getBuildPriority(position), position);
+    }
+
+    const size_t MAX_IN_FLIGHT = mesh_workers.getNumWorkers() * EngineConstants::MESH_JOBS_IN_FLIGHT_PER_WORKER;
+    const size_t NUM_TO_SUBMIT = std::min(MAX_IN_FLIGHT - mesh_workers.getNumJobsInFlight(), prioritized_chunks.size());
+    const auto SUBMITTED_END = prioritized_chunks.begin() + static_cast<std::ptrdiff_t>(NUM_TO_SUBMIT);
+
+    std::partial_sort(prioritized_chunks.begin(), SUBMITTED_END, prioritized_chunks.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    queue.clear();
+    unsigned num_submitted = 0;
+
+    for (auto it = prioritized_chunks.begin(); it != prioritized_chunks.end(); ++it) {
+        if (it >= SUBMITTED_END or (num_submitted != 0 and not hasBudgetFor(average_submit_ms))) {
+            queue.emplace_back(it->second);
+            continue;
+        }
+
+        const auto SUBMIT_BEGIN = Clock::now();
+        queued_chunks.erase(it->second);
+        submitMeshJob(it->second, false);
+        updateAverageCost(average_submit_ms, getElapsedMs(SUBMIT_BEGIN));
+        num_submitted++;
     }
 }
 
-void chisel::ChunkPool::build(const ChunkPosition position) const {
-    if (not isPositionUsed(position)) return;
-    const auto ID = getUsedChunkID(position);
-    chunk_pool.at(ID)->fetchNeighbors(forwardNeighboringChunks(position));
-    chunk_pool.at(ID)->buildMesh();
+// Lower is more urgent, the distance from the viewpoint to the chunk's bounds
+float chisel::ChunkPool::getBuildPriority(const ChunkPosition position) const {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+    using chisel::ChunkDataConstants::CHUNK_HEIGHT;
+
+    AABB bounds {};
+    bounds.vmin = glm::vec3(Conversion::chunkToWorld(position));
+    bounds.vmax = bounds.vmin + glm::vec3(CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE);
+
+    const float DISTANCE = glm::distance(viewpoint_position, glm::clamp(viewpoint_position, bounds.vmin, bounds.vmax));
+    return bounds.isInFrustum(viewpoint_frustum_planes) ? DISTANCE : DISTANCE * OUT_OF_VIEW_DISTANCE_FACTOR;
 }
 
-void chisel::ChunkPool::rebuild(const ChunkPosition position) const {
-    if (not isPositionUsed(position)) return;
-    const auto ID = getUsedChunkID(position);
-    chunk_pool.at(ID)->destroyMesh();
-    chunk_pool.at(ID)->fetchNeighbors(forwardNeighboringChunks(position));
-    chunk_pool.at(ID)->buildMesh();
+// Urgent results are always uploaded, the rest only while the budget allows
+void chisel::ChunkPool::uploadMeshedChunks() {
+    unsigned num_uploaded = 0;
+    MeshResult result {};
+
+    while (mesh_workers.tryPopResult(result, num_uploaded != 0 and not hasBudgetFor(average_upload_ms))) {
+        const auto it = pending_meshes.find(result.position);
+        if (pending_meshes.end() == it or it->second != result.ticket) continue;
+        pending_meshes.erase(it);
+
+        const auto UPLOAD_BEGIN = Clock::now();
+        getUsedChunk(result.position)->uploadMesh(result.data);
+        updateAverageCost(average_upload_ms, getElapsedMs(UPLOAD_BEGIN));
+        num_uploaded++;
+    }
+}
+
+// The old mesh stays on screen until its replacement has been uploaded
+void chisel::ChunkPool::submitMeshJob(const ChunkPosition position, const bool is_urgent) {
+    Chunk* chunk = getUsedChunk(position);
+    if (nullptr == chunk) return;
+
+    // Nothing to draw, any older mesh is dropped right away instead of waiting on a worker
+    if (chunk->isEmpty() or isBuried(position)) {
+        chunk->destroyMesh();
+        pending_meshes.erase(position);
+        return;
+    }
+
+    auto snapshot = std::make_unique<ChunkSnapshot>();
+    snapshot->capture(*chunk, forwardNeighboringChunks(position));
+
+    const MeshTicket TICKET = next_mesh_ticket++;
+    pending_meshes.insert_or_assign(position, TICKET);
+
+    mesh_workers.submit({ position, TICKET, meshing_mode, std::move(snapshot), is_urgent });
+}
+
+bool chisel::ChunkPool::canSubmitMeshJob() const {
+    return mesh_workers.getNumJobsInFlight() < mesh_workers.getNumWorkers() * EngineConstants::MESH_JOBS_IN_FLIGHT_PER_WORKER;
 }
 
 ChunkNeighbors chisel::ChunkPool::forwardNeighboringChunks(const ChunkPosition chunk) const {
-    const auto ID_NORTH = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North));
-    const auto ID_SOUTH = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South));
-    const auto ID_EAST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::East));
-    const auto ID_WEST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::West));
-
-    const auto ID_NORTH_EAST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::East));
-    const auto ID_NORTH_WEST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North | Direction::West));
-    const auto ID_SOUTH_EAST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::East));
-    const auto ID_SOUTH_WEST = getUsedChunkID(chunk + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South | Direction::West));
-
-    return {
-        .north = ID_NORTH != NULL_CHUNK_ID ? chunk_pool.at(ID_NORTH).get() : nullptr,
-        .south = ID_SOUTH != NULL_CHUNK_ID ? chunk_pool.at(ID_SOUTH).get() : nullptr,
-        .east  = ID_EAST != NULL_CHUNK_ID ? chunk_pool.at(ID_EAST).get() : nullptr,
-        .west  = ID_WEST != NULL_CHUNK_ID ? chunk_pool.at(ID_WEST).get() : nullptr,
-
-        .north_east = ID_NORTH_EAST != NULL_CHUNK_ID ? chunk_pool.at(ID_NORTH_EAST).get() : nullptr,
-        .north_west = ID_NORTH_WEST != NULL_CHUNK_ID ? chunk_pool.at(ID_NORTH_WEST).get() : nullptr,
-        .south_east = ID_SOUTH_EAST != NULL_CHUNK_ID ? chunk_pool.at(ID_SOUTH_EAST).get() : nullptr,
-        .south_west = ID_SOUTH_WEST != NULL_CHUNK_ID ? chunk_pool.at(ID_SOUTH_WEST).get() : nullptr
+    ChunkNeighbors neighbors {};
+
+    for (auto const& [_, offset] : CHUNK_NEIGHBORS_DIRECTION) {
+        neighbors.chunks[ChunkNeighbors::toIndex(offset.x, offset.y, offset.z)] = getUsedChunk(chunk + offset);
+    }
+
+    return neighbors;
+}
+
+// A full chunk whose six face neighbors are full as well has no visible face
+bool chisel::ChunkPool::isBuried(const ChunkPosition position) const {
+    constexpr std::array FACE_NEIGHBORS = {
+        Direction::Top, Direction::Bottom, Direction::North, Direction::South, Direction::East, Direction::West
     };
+
+    const Chunk* chunk = getUsedChunk(position);
+    if (nullptr == chunk or not chunk->isFull()) return false;
+
+    return std::all_of(FACE_NEIGHBORS.begin(), FACE_NEIGHBORS.end(), [this, position](const Direction direction) {
+        const Chunk* neighbor = getUsedChunk(position + CHUNK_NEIGHBORS_DIRECTION.at(direction));
+        return nullptr != neighbor and neighbor->isFull();
+    });
 }
 
-void chisel::ChunkPool::renderUsedChunk(const ChunkPosition position) const {
-    if (not isPositionUsed(position)) return;
-    const auto ID = getUsedChunkID(position);
-    chunk_pool.at(ID)->render();
+void chisel::ChunkPool::setMeshingMode(const MeshingMode mode) {
+    if (meshing_mode == mode) return;
+    meshing_mode = mode;
+
+    for (auto const& [position, ID] : chunk_grid) {
+        if (ID == NULL_CHUNK_ID) continue;
+        if (not isBuilt(position) and not isMeshPending(position)) continue;
+        enqueueForRebuilding(position);
+    }
 }
 
-void chisel::ChunkPool::setVoxelIDAtPositionInChunk(const types::VoxelID voxel_id, const LocalPosition local, const ChunkPosition chunk) const {
-    if (not isPositionUsed(chunk)) return;
-    const auto ID = getUsedChunkID(chunk);
-    chunk_pool.at(ID)->setVoxelIDAtPosition(voxel_id, local);
+MeshingMode chisel::ChunkPool::getMeshingMode() const {
+    return meshing_mode;
+}
+
+size_t chisel::ChunkPool::getNumBuiltQuads() const {
+    size_t num_quads = 0;
+
+    for (auto const& [_, ID] : chunk_grid) {
+        if (ID == NULL_CHUNK_ID or nullptr == chunk_pool[ID]) continue;
+        num_quads += chunk_pool[ID]->getNumQuads();
+    }
+
+    return num_quads;
+}
+
+// Counts every pooled chunk but those being generated, recycled ones keep their storage until reused
+size_t chisel::ChunkPool::getVoxelMemoryUsage() const {
+    size_t memory_usage = 0;
+
+    for (size_t ID = 1; ID < chunk_pool.size(); ID++) {
+        if (nullptr == chunk_pool[ID]) continue;
+        memory_usage += chunk_pool[ID]->getVoxelMemoryUsage();
+    }
+
+    return memory_usage;
 }
 
-bool chisel::ChunkPool::isVoidAtInChunk(const LocalPosition local, const ChunkPosition chunk) const {
-    if (not isPositionUsed(chunk)) return false;
-    const auto ID = getUsedChunkID(chunk);
-    return chunk_pool.at(ID)->isVoidAt(local);
+void chisel::ChunkPool::renderUsedChunk(const ChunkPosition position) const {
+    const Chunk* p_chunk = getUsedChunk(position);
+    if (nullptr == p_chunk) return;
+    p_chunk->render();
+}
+
+void chisel::ChunkPool::setVoxelIDAtPositionInChunk(const types::VoxelID voxel_id, const LocalPosition local, const ChunkPosition chunk) const {
+    Chunk* p_chunk = getUsedChunk(chunk);
+    if (nullptr == p_chunk) return;
+    p_chunk->setVoxelIDAtPosition(voxel_id, local);
 }
 
 bool chisel::ChunkPool::isVisible(const ChunkPosition position, const std::array<glm::vec4, 6> &frustum_planes) const {
-    if (not isPositionUsed(position)) return false;
-    const auto ID = getUsedChunkID(position);
-    return chunk_pool.at(ID)->isChunkVisible(frustum_planes);
+    const Chunk* p_chunk = getUsedChunk(position);
+    return nullptr != p_chunk and p_chunk->isChunkVisible(frustum_planes);
 }
 
 bool chisel::ChunkPool::isBuilt(const ChunkPosition position) const {
-    if (not isPositionUsed(position)) return false;
-    const auto ID = getUsedChunkID(position);
-    return chunk_pool.at(ID)->isBuilt();
+    const Chunk* p_chunk = getUsedChunk(position);
+    return nullptr != p_chunk and p_chunk->isBuilt();
 }
 
-const std::vector<ChunkPosition>& chisel::ChunkPool::getUsedChunks() const {
-    static std::vector<ChunkPosition> used_chunks {};
+bool chisel::ChunkPool::isMeshPending(const ChunkPosition position) const {
+    return pending_meshes.count(position) != 0;
+}
+
+void chisel::ChunkPool::getUsedChunks(std::vector<ChunkPosition>& used_chunks) const {
     used_chunks.clear();
 
-    for (auto const& [position, _] : used_chunk_ids) {
+    for (auto const& [position, ID] : chunk_grid) {
+        if (ID == NULL_CHUNK_ID) continue;
         used_chunks.emplace_back(position);
     }
-
-    return used_chunks;
 }
\ No newline at end of file
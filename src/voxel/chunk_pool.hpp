@@ -2,6 +2,7 @@
 #define CHUNK_POOL_HPP
 
 #include <queue>
+#include <chrono>
 #include <vector>
 #include <ranges>
 #include <unordered_set>
@@ -11,24 +12,70 @@
 #include <glm/gtx/hash.hpp>
 
 #include "chunk.hpp"
+#include "mesh_worker_pool.hpp"
+#include "terrain_worker_pool.hpp"
 
 namespace chisel {
     using ChunkID = size_t;
     constexpr ChunkID NULL_CHUNK_ID = 0;
 
+    struct ChunkSlot {
+        ChunkPosition position {};
+        ChunkID id = NULL_CHUNK_ID;
+    };
+
     class ChunkPool {
         std::vector<ChunkPtr> chunk_pool {};
         std::queue<ChunkID> allocated_chunks {};
-        std::unordered_map<ChunkPosition, ChunkID> used_chunk_ids {};
 
-        std::queue<ChunkPosition> build_queue {};
-        std::queue<ChunkPosition> rebuild_queue {};
+        // Wrap-around window over the loaded area, a slot is shared by every position congruent modulo
+        // its size and the stored position tells which one currently owns it
+        std::vector<ChunkSlot> chunk_grid {};
+
+        // Unordered, processQueuedChunks picks the most urgent entries every frame
+        std::vector<ChunkPosition> build_queue {};
+        std::vector<ChunkPosition> rebuild_queue {};
 
         std::unordered_set<ChunkPosition> chunks_to_build {};
         std::unordered_set<ChunkPosition> chunks_to_rebuild {};
 
-        void build(ChunkPosition) const;
-        void rebuild(ChunkPosition) const;
+        // Chunks touched by the player, submitted and uploaded every frame regardless of the budget
+        std::unordered_set<ChunkPosition> edited_chunks {};
+
+        // Latest ticket submitted per position, results carrying an older ticket are stale
+        std::unordered_map<ChunkPosition, MeshTicket> pending_meshes {};
+        MeshTicket next_mesh_ticket = 1;
+
+        glm::vec3 viewpoint_position {};
+        std::array<glm::vec4, 6> viewpoint_frustum_planes {};
+        std::vector<std::pair<float, ChunkPosition>> prioritized_chunks {};
+
+        // Render thread time spent on chunks this frame, and the running cost of each kind of work
+        std::chrono::steady_clock::time_point frame_begin {};
+        float frame_budget_ms = 0.0f;
+        float average_submit_ms = 0.1f;
+        float average_upload_ms = 0.1f;
+
+        MeshingMode meshing_mode = MeshingMode::Greedy;
+        MeshWorkerPool mesh_workers;
+
+        RegionStore region_store;
+
+        // A chunk being generated is owned by its job, its slot in chunk_pool stays empty until it comes back
+        TerrainWorkerPool terrain_workers;
+
+        [[nodiscard]] static size_t toGridIndex(ChunkPosition);
+        [[nodiscard]] Chunk* getUsedChunk(ChunkPosition) const;
+
+        void submitMeshJob(ChunkPosition, bool is_urgent);
+        void submitPrioritizedMeshJobs(std::vector<ChunkPosition> &queue, std::unordered_set<ChunkPosition> &queued_chunks);
+        void uploadMeshedChunks();
+        void collectGeneratedChunks();
+
+        [[nodiscard]] bool canSubmitMeshJob() const;
+        [[nodiscard]] bool hasBudgetFor(float average_cost_ms) const;
+        [[nodiscard]] float getBuildPriority(ChunkPosition) const;
+        [[nodiscard]] bool isBuried(ChunkPosition) const;
 
         [[nodiscard]] ChunkNeighbors forwardNeighboringChunks(ChunkPosition) const;
     public:
@@ -37,24 +84,37 @@ namespace chisel {
 
         void use(ChunkPosition);
         void recycle(ChunkPosition);
+        [[nodiscard]] bool canUse() const;
+        void saveDirtyChunks();
 
         [[nodiscard]] ChunkID getUsedChunkID(ChunkPosition) const;
         [[nodiscard]] bool isPositionUsed(ChunkPosition) const;
 
+        // Read only access for code walking many voxels of a chunk, nullptr while the chunk is unused or generating
+        [[nodiscard]] const Chunk* getLoadedChunk(ChunkPosition) const;
+
         void enqueueForBuilding(ChunkPosition);
         void enqueueForRebuilding(ChunkPosition);
+        void enqueueForEditRebuilding(ChunkPosition);
+
+        void setViewpoint(glm::vec3 position, const std::array<glm::vec4, 6> &frustum_planes);
+
+        void processQueuedChunks(float budget_ms);
 
-        void buildQueuedChunks();
-        void rebuildQueuedChunks();
+        void setMeshingMode(MeshingMode);
+        [[nodiscard]] MeshingMode getMeshingMode() const;
+        [[nodiscard]] size_t getNumBuiltQuads() const;
+        [[nodiscard]] size_t getVoxelMemoryUsage() const;
 
         void renderUsedChunk(ChunkPosition) const;
         void setVoxelIDAtPositionInChunk(types::VoxelID, LocalPosition, ChunkPosition) const;
 
-        [[nodiscard]] bool isVoidAtInChunk(LocalPosition, ChunkPosition) const;
         [[nodiscard]] bool isVisible(ChunkPosition position, const std::array<glm::vec4, 6> &frustum_planes) const;
         [[nodiscard]] bool isBuilt(ChunkPosition) const;
+        [[nodiscard]] bool isMeshPending(ChunkPosition) const;
 
-        [[nodiscard]] const std::vector<ChunkPosition>& getUsedChunks() const;
+        // Fills the vector with the positions of all used chunks, the caller keeps it to reuse its capacity
+        void getUsedChunks(std::vector<ChunkPosition>&) const;
 
         ChunkPool(const ChunkPool&)            = delete;
         ChunkPool& operator=(const ChunkPool&) = delete;
@@ -0,0 +1,136 @@
+#include "chunk_section.hpp"
+
+#include <algorithm>
+
+using chisel::ChunkDataConstants::SECTION_HEIGHT;
+using chisel::ChunkDataConstants::SECTION_VOLUME;
+
+chisel::ChunkSection::ChunkSection(const ChunkSection& other) :
+    state(other.state),
+    uniform_id(other.uniform_id),
+    voxel_ids(other.voxel_ids ? std::make_unique<PaletteStorage>(*other.voxel_ids) : nullptr) {}
+
+chisel::ChunkSection& chisel::ChunkSection::operator=(const ChunkSection& other) {
+    if (this != &other) *this = ChunkSection(other);
+    return *this;
+}
+
+void chisel::ChunkSection::reset() {
+    state = SectionState::Empty;
+    uniform_id = AIR_ID;
+    voxel_ids.reset();
+}
+
+chisel::types::VoxelID chisel::ChunkSection::get(const size_t index) const {
+    if (SectionState::Mixed != state) {
+        if (index >= SECTION_VOLUME) throw std::out_of_range("ChunkSection::get index out of range");
+        return uniform_id;
+    }
+
+    return voxel_ids->get(index);
+}
+
+void chisel::ChunkSection::set(const size_t index, const types::VoxelID voxel_id) {
+    if (SectionState::Mixed != state) {
+        if (index >= SECTION_VOLUME) throw std::out_of_range("ChunkSection::set index out of range");
+        if (uniform_id == voxel_id) return;
+
+        voxel_ids = std::make_unique<PaletteStorage>(SECTION_VOLUME);
+        voxel_ids->fill(uniform_id);
+        state = SectionState::Mixed;
+    }
+
+    voxel_ids->set(index, voxel_id);
+
+    // Only the ID just stored can have taken over the whole section
+    if (SECTION_VOLUME != voxel_ids->getCount(voxel_id)) return;
+
+    if (AIR_ID == voxel_id) {
+        reset();
+        return;
+    }
+
+    state = SectionState::Uniform;
+    uniform_id = voxel_id;
+    voxel_ids.reset();
+}
+
+void chisel::ChunkSection::assign(const types::VoxelID* ids) {
+    const types::VoxelID FIRST_ID = ids[0];
+    unsigned differing_bits = 0; // Stays 0 while every ID matches the first, a branch free loop unlike an early out
+
+    for (size_t index = 0; index < SECTION_VOLUME; index++) {
+        differing_bits |= static_cast<unsigned>(FIRST_ID ^ ids[index]);
+    }
+
+    if (0 == differing_bits) {
+        if (AIR_ID == FIRST_ID) {
+            reset();
+            return;
+        }
+
+        state = SectionState::Uniform;
+        uniform_id = FIRST_ID;
+        voxel_ids.reset();
+        return;
+    }
+
+    if (not voxel_ids) voxel_ids = std::make_unique<PaletteStorage>(SECTION_VOLUME);
+    voxel_ids->assign(ids);
+    state = SectionState::Mixed;
+}
+
+void chisel::ChunkSection::assign(const std::vector<VoxelRun>& runs) {
+    // Voxels of each ID, a section holds few enough IDs for a linear search
+    std::vector<std::pair<types::VoxelID, unsigned>> id_counts {};
+
+    for (const VoxelRun& run : runs) {
+        const auto it = std::find_if(id_counts.begin(), id_counts.end(), [&run](const auto& id_count) {
+            return run.voxel_id == id_count.first;
+        });
+
+        if (id_counts.end() == it) id_counts.emplace_back(run.voxel_id, run.length);
+        else it->second += run.length;
+    }
+
+    if (1 == id_counts.size()) {
+        if (AIR_ID == id_counts[0].first) {
+            reset();
+            return;
+        }
+
+        state = SectionState::Uniform;
+        uniform_id = id_counts[0].first;
+        voxel_ids.reset();
+        return;
+    }
+
+    // The most common ID goes first in the palette, its runs are then left out when filling the storage
+    std::sort(id_counts.begin(), id_counts.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+
+    std::vector<types::VoxelID> palette {};
+    for (const auto& id_count : id_counts) palette.emplace_back(id_count.first);
+
+    if (not voxel_ids) voxel_ids = std::make_unique<PaletteStorage>(SECTION_VOLUME);
+    voxel_ids->assignColumns(std::move(palette), runs, SECTION_HEIGHT);
+    state = SectionState::Mixed;
+}
+
+void chisel::ChunkSection::copyTo(types::VoxelID* ids) const {
+    if (SectionState::Mixed == state) {
+        voxel_ids->copyTo(ids);
+        return;
+    }
+
+    std::fill(ids, ids + SECTION_VOLUME, uniform_id);
+}
+
+chisel::SectionState chisel::ChunkSection::getState() const {
+    return state;
+}
+
+size_t chisel::ChunkSection::getMemoryUsage() const {
+    return voxel_ids ? voxel_ids->getMemoryUsage() : 0;
+}
@@ -0,0 +1,55 @@
+#ifndef CHUNK_SECTION_HPP
+#define CHUNK_SECTION_HPP
+
+#include <vector>
+#include <memory>
+
+#include "engine_constants.hpp"
+#include "palette_storage.hpp"
+
+namespace chisel {
+    enum class SectionState : unsigned {
+        Empty,   // Only air, no storage
+        Uniform, // A single solid voxel ID, no storage
+        Mixed    // Voxels kept in a palette storage
+    };
+
+    /*
+     * SECTION_HEIGHT layers of a chunk.
+     *
+     * Only mixed sections allocate storage. A section is demoted back to empty
+     * as soon as its last solid voxel is removed, and to uniform when it gets
+     * completely filled with one voxel ID.
+    */
+    class ChunkSection {
+        SectionState state = SectionState::Empty;
+        types::VoxelID uniform_id = AIR_ID;
+
+        std::unique_ptr<PaletteStorage> voxel_ids {};
+    public:
+        ChunkSection() = default;
+        ~ChunkSection() = default;
+
+        // Copies own their storage, so a copy can be read on another thread while the original changes
+        ChunkSection(const ChunkSection&);
+        ChunkSection& operator=(const ChunkSection&);
+        ChunkSection(ChunkSection&&)            = default;
+        ChunkSection& operator=(ChunkSection&&) = default;
+
+        void reset();
+
+        [[nodiscard]] types::VoxelID get(size_t index) const;
+        void set(size_t index, types::VoxelID voxel_id);
+
+        // Replaces the whole section with SECTION_VOLUME voxel IDs laid out as by get and set
+        void assign(const types::VoxelID* ids);
+        // Replaces the whole section with runs covering its columns in order, column (x, z) being x + z * CHUNK_SIZE
+        void assign(const std::vector<VoxelRun>& runs);
+        void copyTo(types::VoxelID* ids) const;
+
+        [[nodiscard]] SectionState getState() const;
+        [[nodiscard]] size_t getMemoryUsage() const;
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "chunk_snapshot.hpp"
+#include "chunk.hpp"
+
+int getNeighborOffset(const int coordinate, const int extent) {
+    return coordinate < 0 ? -1 : (coordinate < extent ? 0 : 1);
+}
+
+void ChunkSnapshot::capture(const Chunk &chunk, const ChunkNeighbors &neighbors) {
+    using chisel::ChunkDataConstants::CHUNK_HEIGHT;
+    constexpr auto CHUNK_SIZE = static_cast<int>(chisel::ChunkDataConstants::CHUNK_SIZE);
+    constexpr auto TOP = static_cast<int>(CHUNK_HEIGHT);
+
+    std::fill(voxel_ids.begin(), voxel_ids.end(), chisel::AIR_ID);
+
+    for (int z = -1; z <= CHUNK_SIZE; z++) {
+        for (int x = -1; x <= CHUNK_SIZE; x++) {
+            const int dx = getNeighborOffset(x, CHUNK_SIZE);
+            const int dz = getNeighborOffset(z, CHUNK_SIZE);
+            const auto LOCAL_X = static_cast<unsigned>(x - dx * CHUNK_SIZE);
+            const auto LOCAL_Z = static_cast<unsigned>(z - dz * CHUNK_SIZE);
+
+            ColumnMask padded_column = 0;
+
+            for (int dy = -1; dy <= 1; dy++) {
+                const Chunk* source = 0 == dx and 0 == dy and 0 == dz ? &chunk : neighbors.chunks[ChunkNeighbors::toIndex(dx, dy, dz)];
+                if (nullptr == source or source->isEmpty()) continue;
+
+                const ColumnMask COLUMN = source->getColumnMask(LOCAL_X, LOCAL_Z);
+
+                // Only the layer touching the chunk is taken from the chunks above and below
+                if (-1 == dy) {
+                    if (0 == (COLUMN >> (CHUNK_HEIGHT - 1) & 1)) continue;
+                    padded_column |= 1;
+                    voxel_ids[toPaddedIndex(x, -1, z)] = source->getVoxelID({ LOCAL_X, CHUNK_HEIGHT - 1, LOCAL_Z });
+                } else if (1 == dy) {
+                    if (0 == (COLUMN & 1)) continue;
+                    padded_column |= static_cast<ColumnMask>(1) << (CHUNK_HEIGHT + 1);
+                    voxel_ids[toPaddedIndex(x, TOP, z)] = source->getVoxelID({ LOCAL_X, 0, LOCAL_Z });
+                } else {
+                    padded_column |= COLUMN << 1;
+
+                    // The volume starts out as air, only solid voxels are copied so empty sections cost nothing
+                    for (ColumnMask solid = COLUMN; 0 != solid; solid &= solid - 1) {
+                        const unsigned y = countTrailingZeros(solid);
+                        voxel_ids[toPaddedIndex(x, static_cast<int>(y), z)] = source->getVoxelID({ LOCAL_X, y, LOCAL_Z });
+                    }
+                }
+            }
+
+            column_masks[toPaddedColumnIndex(x, z)] = padded_column;
+        }
+    }
+}
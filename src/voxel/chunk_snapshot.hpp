@@ -0,0 +1,86 @@
+#ifndef CHUNK_SNAPSHOT_HPP
+#define CHUNK_SNAPSHOT_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "conversions.hpp"
+#include "block_registry.hpp"
+#include "engine_constants.hpp"
+
+class Chunk;
+
+// Bit y is set when the voxel at height y of a column is solid
+using ColumnMask = uint64_t;
+static_assert(chisel::ChunkDataConstants::CHUNK_HEIGHT + 2 <= 64, "A padded chunk column must fit in a ColumnMask");
+
+// Height of the lowest set bit, the mask must not be 0
+inline unsigned countTrailingZeros(const ColumnMask mask) {
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+}
+
+// Column masks of the chunk surrounded by a one column apron taken from its neighbors
+using PaddedColumnMasks = std::array<ColumnMask, chisel::ChunkDataConstants::PADDED_CHUNK_SIZE * chisel::ChunkDataConstants::PADDED_CHUNK_SIZE>;
+
+// The 26 chunks around a chunk, nullptr where no chunk is loaded
+struct ChunkNeighbors {
+    std::array<const Chunk*, 27> chunks {};
+
+    // dx, dy and dz range from -1 to 1, the center entry is never used
+    [[nodiscard]] static constexpr unsigned toIndex(const int dx, const int dy, const int dz) {
+        return static_cast<unsigned>((dx + 1) + 3 * (dz + 1) + 9 * (dy + 1));
+    }
+};
+
+/*
+ * Copy of a chunk's voxels surrounded by a one voxel apron taken from its
+ * 26 neighbors. Column masks cover the apron above and below the chunk too,
+ * bit 0 is the layer under the chunk.
+ *
+ * Meshing only reads from the snapshot, so it holds no pointers into the
+ * pool and can be processed away from the thread that captured it.
+*/
+class ChunkSnapshot {
+public:
+    static constexpr unsigned PADDED_SIZE = chisel::ChunkDataConstants::PADDED_CHUNK_SIZE;
+    static constexpr unsigned PADDED_HEIGHT = chisel::ChunkDataConstants::CHUNK_HEIGHT + 2;
+    static constexpr unsigned PADDED_VOLUME = PADDED_SIZE * PADDED_SIZE * PADDED_HEIGHT;
+
+    static constexpr int STRIDE_X = 1;
+    static constexpr int STRIDE_Z = static_cast<int>(PADDED_SIZE);
+    static constexpr int STRIDE_Y = static_cast<int>(PADDED_SIZE * PADDED_SIZE);
+
+private:
+    std::array<chisel::types::VoxelID, PADDED_VOLUME> voxel_ids {};
+    PaddedColumnMasks column_masks {};
+
+public:
+    void capture(const Chunk &chunk, const ChunkNeighbors &neighbors);
+
+    // x, y and z range from -1 to the chunk's extent on that axis
+    [[nodiscard]] static unsigned toPaddedIndex(int x, int y, int z) {
+        return static_cast<unsigned>((x + 1) * STRIDE_X + (y + 1) * STRIDE_Y + (z + 1) * STRIDE_Z);
+    }
+
+    [[nodiscard]] static unsigned toPaddedColumnIndex(int x, int z) {
+        return static_cast<unsigned>(x + 1) + PADDED_SIZE * static_cast<unsigned>(z + 1);
+    }
+
+    [[nodiscard]] chisel::types::VoxelID getVoxelID(const unsigned padded_index) const {
+        return voxel_ids[padded_index];
+    }
+
+    static constexpr ColumnMask INNER_COLUMN_MASK = (static_cast<ColumnMask>(1) << chisel::ChunkDataConstants::CHUNK_HEIGHT) - 1;
+
+    // Bit y is set when the voxel at height y is solid, for y within the chunk
+    [[nodiscard]] ColumnMask getColumnMask(const int x, const int z) const {
+        return column_masks[toPaddedColumnIndex(x, z)] >> 1 & INNER_COLUMN_MASK;
+    }
+
+    // Bit y + 1 is set when the voxel at height y is solid, for y from -1 to CHUNK_HEIGHT
+    [[nodiscard]] ColumnMask getPaddedColumnMask(const int x, const int z) const {
+        return column_masks[toPaddedColumnIndex(x, z)];
+    }
+};
+
+#endif
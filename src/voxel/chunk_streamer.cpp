@@ -0,0 +1,115 @@
+#include "chunk_streamer.hpp"
+
+#include <algorithm>
+
+using Clock = std::chrono::steady_clock;
+
+// Calls f on every position of the window that lies outside the excluded window. Columns within the
+// excluded x and z range are only visited for the layers above and below it, and not at all when the
+// window did not move vertically, so a move costs the slabs it enters or leaves
+template <typename F>
+void forEachOutside(const chisel::ChunkWindow &window, const chisel::ChunkWindow &excluded, F &&f) {
+    const int Y_BELOW = std::min(window.y_max, excluded.y_min - 1);
+    const int Y_ABOVE = std::max(window.y_min, excluded.y_max + 1);
+    const bool HAS_Y_OUTSIDE = Y_BELOW >= window.y_min or Y_ABOVE <= window.y_max;
+
+    const auto forEachInColumn = [&window, &f](const int x, const int z) {
+        for (int y = window.y_min; y <= window.y_max; y++) f(ChunkPosition(x, y, z));
+    };
+
+    for (int x = window.x_min; x <= window.x_max; x++) {
+        if (x < excluded.x_min or x > excluded.x_max) {
+            for (int z = window.z_min; z <= window.z_max; z++) forEachInColumn(x, z);
+            continue;
+        }
+
+        const int Z_BEFORE = std::min(window.z_max, excluded.z_min - 1);
+        const int Z_AFTER = std::max(window.z_min, excluded.z_max + 1);
+
+        for (int z = window.z_min; z <= Z_BEFORE; z++) forEachInColumn(x, z);
+        for (int z = Z_AFTER; z <= window.z_max; z++) forEachInColumn(x, z);
+
+        if (not HAS_Y_OUTSIDE) continue;
+
+        for (int z = std::max(window.z_min, excluded.z_min); z <= std::min(window.z_max, excluded.z_max); z++) {
+            for (int y = window.y_min; y <= Y_BELOW; y++) f(ChunkPosition(x, y, z));
+            for (int y = Y_ABOVE; y <= window.y_max; y++) f(ChunkPosition(x, y, z));
+        }
+    }
+}
+
+int getSquaredDistance(const ChunkPosition a, const ChunkPosition b) {
+    const int dx = a.x - b.x;
+    const int dy = a.y - b.y;
+    const int dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+chisel::ChunkWindow chisel::ChunkWindow::around(const ChunkPosition center) {
+    constexpr int DISTANCE = static_cast<int>(EngineConstants::LOAD_DISTANCE);
+    constexpr int VERTICAL_DISTANCE = static_cast<int>(EngineConstants::VERTICAL_LOAD_DISTANCE);
+    return {
+        center.x - DISTANCE,          center.x + DISTANCE,
+        center.y - VERTICAL_DISTANCE, center.y + VERTICAL_DISTANCE,
+        center.z - DISTANCE,          center.z + DISTANCE
+    };
+}
+
+bool chisel::ChunkWindow::contains(const ChunkPosition position) const {
+    return x_min <= position.x and position.x <= x_max
+        and y_min <= position.y and position.y <= y_max
+        and z_min <= position.z and position.z <= z_max;
+}
+
+chisel::ChunkStreamer::ChunkStreamer(ChunkPool &pool) : pool(pool) {}
+
+void chisel::ChunkStreamer::setCenter(const ChunkPosition new_center) {
+    const ChunkWindow NEW_WINDOW = ChunkWindow::around(new_center);
+    if (NEW_WINDOW.x_min == window.x_min and NEW_WINDOW.y_min == window.y_min and NEW_WINDOW.z_min == window.z_min
+        and window.x_min <= window.x_max) return;
+
+    forEachOutside(window, NEW_WINDOW, [this](const ChunkPosition position) {
+        pool.recycle(position);
+    });
+
+    // Entries queued for a previous window may have left it again before being loaded
+    const auto LEFT = std::remove_if(pending_loads.begin(), pending_loads.end(), [&NEW_WINDOW](const ChunkPosition position) {
+        return not NEW_WINDOW.contains(position);
+    });
+    pending_loads.erase(LEFT, pending_loads.end());
+
+    forEachOutside(NEW_WINDOW, window, [this](const ChunkPosition position) {
+        pending_loads.emplace_back(position);
+    });
+
+    window = NEW_WINDOW;
+    center = new_center;
+
+    // The kept entries were ordered around the previous center, so the whole queue is sorted again
+    std::sort(pending_loads.begin(), pending_loads.end(), [this](const ChunkPosition a, const ChunkPosition b) {
+        return getSquaredDistance(a, center) > getSquaredDistance(b, center);
+    });
+}
+
+// Hands the nearest pending chunks to the terrain workers until the budget runs out or their queue is full
+void chisel::ChunkStreamer::processPendingLoads(const float budget_ms) {
+    const auto BEGIN = Clock::now();
+
+    while (not pending_loads.empty() and pool.canUse()) {
+        const ChunkPosition position = pending_loads.back();
+        pending_loads.pop_back();
+
+        if (pool.isPositionUsed(position)) continue;
+        pool.use(position);
+
+        if (std::chrono::duration<float, std::milli>(Clock::now() - BEGIN).count() >= budget_ms) break;
+    }
+}
+
+size_t chisel::ChunkStreamer::getNumPendingLoads() const {
+    return pending_loads.size();
+}
+
+const std::vector<ChunkPosition>& chisel::ChunkStreamer::getPendingLoads() const {
+    return pending_loads;
+}
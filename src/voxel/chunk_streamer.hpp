@@ -0,0 +1,55 @@
+#ifndef CHUNK_STREAMER_HPP
+#define CHUNK_STREAMER_HPP
+
+#include <vector>
+
+#include "chunk_pool.hpp"
+
+namespace chisel {
+    // Box of chunks within LOAD_DISTANCE of a center, and VERTICAL_LOAD_DISTANCE above and below it.
+    // Bounds are inclusive
+    struct ChunkWindow {
+        int x_min = 0, x_max = -1;
+        int y_min = 0, y_max = -1;
+        int z_min = 0, z_max = -1;
+
+        [[nodiscard]] static ChunkWindow around(ChunkPosition center);
+        [[nodiscard]] bool contains(ChunkPosition) const;
+    };
+
+    /*
+     * Keeps the pool filled with the chunks around the player.
+     *
+     * Moving the center only walks the slabs of the window that were left and
+     * entered, so crossing a chunk boundary costs the area of a window face.
+     * Leaving chunks are recycled at once, entering ones are queued nearest first
+     * and handed to the pool over the following frames, which generates them on
+     * its terrain workers and meshes them once they are back.
+    */
+    class ChunkStreamer {
+        ChunkPool& pool;
+
+        ChunkWindow window {};
+        ChunkPosition center {};
+
+        // Sorted farthest first so the nearest chunk is popped from the back
+        std::vector<ChunkPosition> pending_loads {};
+    public:
+        explicit ChunkStreamer(ChunkPool&);
+        ~ChunkStreamer() = default;
+
+        void setCenter(ChunkPosition);
+        void processPendingLoads(float budget_ms);
+
+        [[nodiscard]] size_t getNumPendingLoads() const;
+        // Farthest first, the next chunk to load is at the back
+        [[nodiscard]] const std::vector<ChunkPosition>& getPendingLoads() const;
+
+        ChunkStreamer(const ChunkStreamer&)            = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        ChunkStreamer(ChunkStreamer&&)                 = delete;
+        ChunkStreamer& operator=(ChunkStreamer&&)      = delete;
+    };
+}
+
+#endif
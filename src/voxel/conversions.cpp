@@ -1,15 +1,16 @@
 #include "conversions.hpp"
 
+// Chunk dimensions are powers of two, so conversions are shifts and masks. Right shifts of negative
+// positions are arithmetic and round towards negative infinity like a floored division would.
+// Ray casts step voxel by voxel and edits touch one block, so every caller converts a single position
+
 VoxelIndex Conversion::toIndex(const LocalPosition local) {
-    return local.x + chisel::ChunkDataConstants::CHUNK_SIZE * local.z + chisel::ChunkDataConstants::CHUNK_AREA * local.y;
+    using namespace chisel::ChunkDataConstants;
+    return local.x | local.z << X_SIZE | local.y << (X_SIZE + Z_SIZE);
 }
 
 WorldPosition Conversion::toWorld(const LocalPosition local, const ChunkPosition chunk) {
-    return {
-        static_cast<int>(local.x) + chunk.x * static_cast<int>(chisel::ChunkDataConstants::CHUNK_SIZE),
-        static_cast<int>(local.y) + chunk.y * static_cast<int>(chisel::ChunkDataConstants::CHUNK_HEIGHT),
-        static_cast<int>(local.z) + chunk.z * static_cast<int>(chisel::ChunkDataConstants::CHUNK_SIZE)
-    };
+    return chunkToWorld(chunk) + WorldPosition(local);
 }
 
 WorldPosition Conversion::toWorld(const glm::vec3 any_position) {
@@ -25,26 +26,20 @@ WorldPosition Conversion::chunkToWorld(const ChunkPosition chunk) {
 }
 
 ChunkPosition Conversion::toChunk(const WorldPosition world) {
-    return {
-        static_cast<int>(glm::floor(static_cast<float>(world.x) / static_cast<float>(chisel::ChunkDataConstants::CHUNK_SIZE))),
-        static_cast<int>(glm::floor(static_cast<float>(world.y) / static_cast<float>(chisel::ChunkDataConstants::CHUNK_HEIGHT))),
-        static_cast<int>(glm::floor(static_cast<float>(world.z) / static_cast<float>(chisel::ChunkDataConstants::CHUNK_SIZE)))
-    };
+    using namespace chisel::ChunkDataConstants;
+    return { world.x >> X_SIZE, world.y >> Y_SIZE, world.z >> Z_SIZE };
 }
 
 ChunkPosition Conversion::toChunk(const glm::vec3 any_position) {
-    return {
-        static_cast<int>(glm::floor(any_position.x / static_cast<float>(chisel::ChunkDataConstants::CHUNK_SIZE))),
-        static_cast<int>(glm::floor(any_position.y / static_cast<float>(chisel::ChunkDataConstants::CHUNK_HEIGHT))),
-        static_cast<int>(glm::floor(any_position.z / static_cast<float>(chisel::ChunkDataConstants::CHUNK_SIZE)))
-    };
+    return toChunk(toWorld(any_position));
 }
 
-LocalPosition Conversion::toLocal(const WorldPosition world, const ChunkPosition chunk) {
+LocalPosition Conversion::toLocal(const WorldPosition world) {
+    using namespace chisel::ChunkDataConstants;
     return {
-        static_cast<unsigned>(world.x - chunk.x * static_cast<int>(chisel::ChunkDataConstants::CHUNK_SIZE)),
-        static_cast<unsigned>(world.y - chunk.y * static_cast<int>(chisel::ChunkDataConstants::CHUNK_HEIGHT)),
-        static_cast<unsigned>(world.z - chunk.z * static_cast<int>(chisel::ChunkDataConstants::CHUNK_SIZE))
+        static_cast<unsigned>(world.x) & CHUNK_SIZE_MASK,
+        static_cast<unsigned>(world.y) & CHUNK_HEIGHT_MASK,
+        static_cast<unsigned>(world.z) & CHUNK_SIZE_MASK
     };
 }
 
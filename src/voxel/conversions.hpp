@@ -22,7 +22,7 @@ namespace Conversion {
     [[nodiscard]] ChunkPosition toChunk(WorldPosition);
     [[nodiscard]] ChunkPosition toChunk(glm::vec3 any_position);
 
-    [[nodiscard]] LocalPosition toLocal(WorldPosition, ChunkPosition);
+    [[nodiscard]] LocalPosition toLocal(WorldPosition);
 
     [[nodiscard]] glm::mat4 toChunkModel(ChunkPosition);
 
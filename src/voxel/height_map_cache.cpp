@@ -0,0 +1,77 @@
+#include "height_map_cache.hpp"
+
+using chisel::EngineConstants::HEIGHT_MAP_REGION_SHIFT;
+using chisel::EngineConstants::HEIGHT_MAP_REGION_SIZE;
+
+// Enough regions to cover the load window plus one row of them on each side
+constexpr unsigned REGIONS_ACROSS = (2 * chisel::EngineConstants::LOAD_DISTANCE + 1) / HEIGHT_MAP_REGION_SIZE + 2;
+constexpr size_t MAX_CACHED_REGIONS = (REGIONS_ACROSS + 1) * (REGIONS_ACROSS + 1);
+
+void chisel::HeightMapCache::getHeightMap(TerrainNoise& terrain_noise, const ChunkPosition chunk, HeightMap& height_map) {
+    const glm::ivec2 REGION { chunk.x >> HEIGHT_MAP_REGION_SHIFT, chunk.z >> HEIGHT_MAP_REGION_SHIFT };
+
+    constexpr int REGION_MASK = HEIGHT_MAP_REGION_SIZE - 1;
+    const auto CHUNK_X = static_cast<unsigned>(chunk.x & REGION_MASK);
+    const auto CHUNK_Z = static_cast<unsigned>(chunk.z & REGION_MASK);
+
+    std::unique_lock lock(regions_mutex);
+
+    while (true) {
+        const auto it = regions.find(REGION);
+
+        if (it != regions.end() and it->second.is_ready) {
+            TerrainNoise::sliceHeightMap(it->second.heights, HEIGHT_MAP_REGION_SIZE, CHUNK_X, CHUNK_Z, height_map);
+            return;
+        }
+
+        if (it != regions.end()) {
+            regions_condition.wait(lock);
+            continue;
+        }
+
+        // Claim the region so other threads wait for it instead of generating it again
+        if (regions.size() >= MAX_CACHED_REGIONS) evictFarthestFrom(REGION);
+        regions.try_emplace(REGION);
+        lock.unlock();
+
+        const ChunkPosition ORIGIN { REGION.x << HEIGHT_MAP_REGION_SHIFT, 0, REGION.y << HEIGHT_MAP_REGION_SHIFT };
+        std::vector<float> heights {};
+
+        // Drop the claim on failure, threads waiting for the region would never be woken otherwise
+        try {
+            terrain_noise.getHeightMapRegion(heights, ORIGIN, HEIGHT_MAP_REGION_SIZE);
+            TerrainNoise::sliceHeightMap(heights, HEIGHT_MAP_REGION_SIZE, CHUNK_X, CHUNK_Z, height_map);
+        } catch (...) {
+            lock.lock();
+            regions.erase(REGION);
+            regions_condition.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        regions[REGION] = { std::move(heights), true };
+        regions_condition.notify_all();
+        return;
+    }
+}
+
+// Regions still being generated are never evicted, their owner is about to fill them
+void chisel::HeightMapCache::evictFarthestFrom(const glm::ivec2 region) {
+    auto farthest = regions.end();
+    int farthest_distance = -1;
+
+    for (auto it = regions.begin(); it != regions.end(); ++it) {
+        if (not it->second.is_ready) continue;
+
+        const glm::ivec2 DELTA = glm::abs(it->first - region);
+        const int DISTANCE = std::max(DELTA.x, DELTA.y);
+
+        if (DISTANCE > farthest_distance) {
+            farthest_distance = DISTANCE;
+            farthest = it;
+        }
+    }
+
+    if (farthest != regions.end()) regions.erase(farthest);
+}
+
@@ -0,0 +1,42 @@
+#ifndef HEIGHT_MAP_CACHE_HPP
+#define HEIGHT_MAP_CACHE_HPP
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <condition_variable>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include "proc_gen.hpp"
+
+namespace chisel {
+    struct HeightMapRegion {
+        std::vector<float> heights {};
+        bool is_ready = false;
+    };
+
+    /*
+     * Heightmaps of HEIGHT_MAP_REGION_SIZE x HEIGHT_MAP_REGION_SIZE chunk columns.
+     *
+     * A missing region is generated with a single noise call, which costs far less
+     * than one call per chunk, and every chunk of the region and of its vertical
+     * column is then served a copy of its slice. Regions farthest from the latest
+     * request are dropped once the window has moved on.
+     *
+     * Safe to share between threads, a region is generated outside the lock with
+     * the caller's noise and other threads asking for it wait until it is ready.
+    */
+    class HeightMapCache {
+        std::mutex regions_mutex {};
+        std::condition_variable regions_condition {};
+        std::unordered_map<glm::ivec2, HeightMapRegion> regions {};
+
+        void evictFarthestFrom(glm::ivec2 region);
+    public:
+        void getHeightMap(TerrainNoise&, ChunkPosition, HeightMap&);
+    };
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include "mesh_worker_pool.hpp"
+
+chisel::MeshWorkerPool::MeshWorkerPool(const unsigned num_workers) {
+    workers.reserve(num_workers);
+
+    for (unsigned i = 0; i < num_workers; i++) {
+        workers.emplace_back(&MeshWorkerPool::work, this);
+    }
+}
+
+chisel::MeshWorkerPool::~MeshWorkerPool() {
+    {
+        const std::lock_guard lock(jobs_mutex);
+        is_stopping = true;
+    }
+
+    jobs_condition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Copies the scratch output into vectors sized to the actual geometry, the scratch keeps its capacity
+void copyMeshData(const ChunkMeshData &scratch, ChunkMeshData &mesh_data) {
+    mesh_data.quads = std::vector<Quad>(scratch.quads.begin(), scratch.quads.end());
+    mesh_data.bounding_box = scratch.bounding_box;
+}
+
+void chisel::MeshWorkerPool::work() {
+    // Per-thread arena the mesher writes into, reused for every job this worker runs
+    ChunkMeshData scratch {};
+    scratch.quads.reserve(EngineConstants::RESERVED_MESH_FACES_PER_WORKER);
+
+    while (true) {
+        MeshJob job {};
+
+        {
+            std::unique_lock lock(jobs_mutex);
+            jobs_condition.wait(lock, [this] { return is_stopping or not urgent_jobs.empty() or not jobs.empty(); });
+            if (is_stopping) return;
+
+            std::queue<MeshJob>& queue = urgent_jobs.empty() ? jobs : urgent_jobs;
+            job = std::move(queue.front());
+            queue.pop();
+        }
+
+        buildMeshData(*job.snapshot, job.mode, scratch);
+        job.snapshot.reset();
+
+        MeshResult result { job.position, job.ticket, {}, job.is_urgent };
+        copyMeshData(scratch, result.data);
+
+        const std::lock_guard lock(results_mutex);
+        (result.is_urgent ? urgent_results : results).emplace(std::move(result));
+    }
+}
+
+void chisel::MeshWorkerPool::submit(MeshJob &&job) {
+    {
+        const std::lock_guard lock(jobs_mutex);
+        (job.is_urgent ? urgent_jobs : jobs).emplace(std::move(job));
+    }
+
+    num_jobs_in_flight++;
+    jobs_condition.notify_one();
+}
+
+bool chisel::MeshWorkerPool::tryPopResult(MeshResult &result, const bool is_urgent_only) {
+    const std::lock_guard lock(results_mutex);
+
+    std::queue<MeshResult>& queue = is_urgent_only or not urgent_results.empty() ? urgent_results : results;
+    if (queue.empty()) return false;
+
+    result = std::move(queue.front());
+    queue.pop();
+    num_jobs_in_flight--;
+
+    return true;
+}
+
+size_t chisel::MeshWorkerPool::getNumJobsInFlight() const {
+    return num_jobs_in_flight;
+}
+
+size_t chisel::MeshWorkerPool::getNumWorkers() const {
+    return workers.size();
+}
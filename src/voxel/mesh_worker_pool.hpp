@@ -0,0 +1,75 @@
+#ifndef MESH_WORKER_POOL_HPP
+#define MESH_WORKER_POOL_HPP
+
+#include <queue>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "chunk_mesher.hpp"
+#include "chunk_snapshot.hpp"
+
+namespace chisel {
+    using MeshTicket = uint64_t;
+
+    struct MeshJob {
+        ChunkPosition position {};
+        MeshTicket ticket {};
+        MeshingMode mode {};
+        std::unique_ptr<ChunkSnapshot> snapshot {};
+
+        // Urgent jobs and their results skip ahead of everything else queued
+        bool is_urgent = false;
+    };
+
+    struct MeshResult {
+        ChunkPosition position {};
+        MeshTicket ticket {};
+        ChunkMeshData data {};
+        bool is_urgent = false;
+    };
+
+    /*
+     * Runs buildMeshData on snapshots away from the render thread.
+     *
+     * Jobs only own a snapshot, so workers never touch the chunk pool or GL.
+     * Finished meshes are handed back with the ticket of the job, the caller
+     * decides whether the result is still wanted and uploads it.
+    */
+    class MeshWorkerPool {
+        std::vector<std::thread> workers {};
+
+        std::mutex jobs_mutex {};
+        std::condition_variable jobs_condition {};
+        std::queue<MeshJob> urgent_jobs {};
+        std::queue<MeshJob> jobs {};
+        bool is_stopping = false;
+
+        std::mutex results_mutex {};
+        std::queue<MeshResult> urgent_results {};
+        std::queue<MeshResult> results {};
+
+        // Only touched by the thread submitting jobs and popping results
+        size_t num_jobs_in_flight = 0;
+
+        void work();
+    public:
+         explicit MeshWorkerPool(unsigned num_workers);
+        ~MeshWorkerPool();
+
+        void submit(MeshJob &&job);
+        [[nodiscard]] bool tryPopResult(MeshResult &result, bool is_urgent_only);
+
+        [[nodiscard]] size_t getNumJobsInFlight() const;
+        [[nodiscard]] size_t getNumWorkers() const;
+
+        MeshWorkerPool(const MeshWorkerPool&)            = delete;
+        MeshWorkerPool& operator=(const MeshWorkerPool&) = delete;
+        MeshWorkerPool(MeshWorkerPool&&)                 = delete;
+        MeshWorkerPool& operator=(MeshWorkerPool&&)      = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include "palette_storage.hpp"
+
+#include <array>
+#include <algorithm>
+
+constexpr unsigned WORD_BITS = 64;
+constexpr unsigned MAX_BITS_PER_VOXEL = 16;
+
+unsigned readIndex(const std::vector<uint64_t> &words, const unsigned bits, const size_t index) {
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits;
+    const auto SHIFT = static_cast<unsigned>(index % VOXELS_PER_WORD) * bits;
+    const uint64_t MASK = (static_cast<uint64_t>(1) << bits) - 1;
+
+    return static_cast<unsigned>((words[index / VOXELS_PER_WORD] >> SHIFT) & MASK);
+}
+
+void writeIndex(std::vector<uint64_t> &words, const unsigned bits, const size_t index, const unsigned value) {
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits;
+    const auto SHIFT = static_cast<unsigned>(index % VOXELS_PER_WORD) * bits;
+    const uint64_t MASK = (static_cast<uint64_t>(1) << bits) - 1;
+
+    uint64_t& word = words[index / VOXELS_PER_WORD];
+    word = (word & ~(MASK << SHIFT)) | (static_cast<uint64_t>(value) << SHIFT);
+}
+
+chisel::PaletteStorage::PaletteStorage(const size_t size) : size(size) {
+    fill(AIR_ID);
+}
+
+size_t chisel::PaletteStorage::getNumWords(const size_t size, const unsigned bits_per_voxel) {
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits_per_voxel;
+    return (size + VOXELS_PER_WORD - 1) / VOXELS_PER_WORD;
+}
+
+unsigned chisel::PaletteStorage::getBitsForPaletteSize(const size_t palette_size) {
+    unsigned bits = 1;
+    while ((static_cast<size_t>(1) << bits) < palette_size and bits < MAX_BITS_PER_VOXEL) bits *= 2;
+    return bits;
+}
+
+// Doubles the index width, every voxel keeps its palette index
+void chisel::PaletteStorage::grow() {
+    const unsigned NEW_BITS = bits_per_voxel * 2;
+    std::vector<uint64_t> new_words(getNumWords(size, NEW_BITS), 0);
+
+    for (size_t index = 0; index < size; index++) {
+        writeIndex(new_words, NEW_BITS, index, readIndex(words, bits_per_voxel, index));
+    }
+
+    words = std::move(new_words);
+    bits_per_voxel = NEW_BITS;
+}
+
+void chisel::PaletteStorage::fill(const types::VoxelID voxel_id) {
+    // Replaced rather than cleared so a storage that had grown gives its memory back
+    palette = std::vector<types::VoxelID> { voxel_id };
+    palette_counts = std::vector<uint32_t> { static_cast<uint32_t>(size) };
+    bits_per_voxel = 1;
+    words = std::vector<uint64_t>(getNumWords(size, bits_per_voxel), 0);
+}
+
+// Packs size voxel IDs at once, the index width is picked from the final palette instead of grown
+void chisel::PaletteStorage::assign(const types::VoxelID* voxel_ids) {
+    palette.clear();
+    std::vector<uint16_t> palette_indices(size);
+
+    // Palette index of the IDs met so far by their low bits, block IDs are few and dense so slots rarely collide
+    struct PaletteSlot {
+        uint32_t voxel_id = UINT32_MAX;
+        uint16_t palette_index = 0;
+    };
+
+    std::array<PaletteSlot, 256> slots {};
+
+    for (size_t index = 0; index < size; index++) {
+        const types::VoxelID VOXEL_ID = voxel_ids[index];
+        PaletteSlot& slot = slots[VOXEL_ID & 0xFF];
+
+        if (VOXEL_ID != slot.voxel_id) {
+            auto it = std::find(palette.begin(), palette.end(), VOXEL_ID);
+            if (palette.end() == it) it = palette.insert(palette.end(), VOXEL_ID);
+
+            slot = { VOXEL_ID, static_cast<uint16_t>(it - palette.begin()) };
+        }
+
+        palette_indices[index] = slot.palette_index;
+    }
+
+    palette_counts = std::vector<uint32_t>(palette.size(), 0);
+    for (const uint16_t palette_index : palette_indices) palette_counts[palette_index]++;
+
+    bits_per_voxel = getBitsForPaletteSize(palette.size());
+    words = std::vector<uint64_t>(getNumWords(size, bits_per_voxel), 0);
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits_per_voxel;
+
+    // Packed a word at a time like copyTo unpacks them, no division per voxel
+    for (size_t word_index = 0, index = 0; word_index < words.size(); word_index++) {
+        uint64_t word = 0;
+
+        for (size_t i = 0; i < VOXELS_PER_WORD and index < size; i++, index++) {
+            word |= static_cast<uint64_t>(palette_indices[index]) << (i * bits_per_voxel);
+        }
+
+        words[word_index] = word;
+    }
+}
+
+// Only the runs of IDs other than palette[0] are written. Words are found by shifting, dividing by the
+// runtime number of voxels per word would cost more than the write itself
+void chisel::PaletteStorage::assignColumns(std::vector<types::VoxelID> new_palette, const std::vector<VoxelRun>& runs, const size_t column_height) {
+    palette = std::move(new_palette);
+    palette_counts = std::vector<uint32_t>(palette.size(), 0);
+    bits_per_voxel = getBitsForPaletteSize(palette.size());
+    words = std::vector<uint64_t>(getNumWords(size, bits_per_voxel), 0);
+
+    const size_t NUM_COLUMNS = size / column_height;
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits_per_voxel;
+
+    unsigned word_shift = 0;
+    while ((static_cast<size_t>(1) << word_shift) < VOXELS_PER_WORD) word_shift++;
+
+    size_t num_assigned = 0;
+    size_t column = 0, y = 0;
+
+    for (const VoxelRun& run : runs) {
+        if (run.length > size - num_assigned) throw std::out_of_range("PaletteStorage::assignColumns runs exceed the storage");
+        num_assigned += run.length;
+
+        const auto it = std::find(palette.begin(), palette.end(), run.voxel_id);
+        if (palette.end() == it) throw std::invalid_argument("PaletteStorage::assignColumns ID missing from the palette");
+
+        const auto PALETTE_INDEX = static_cast<uint64_t>(it - palette.begin());
+        palette_counts[PALETTE_INDEX] += run.length;
+
+        if (0 == PALETTE_INDEX) {
+            y += run.length;
+            column += y / column_height;
+            y %= column_height;
+            continue;
+        }
+
+        for (size_t remaining = run.length; remaining > 0;) {
+            const size_t LENGTH = std::min(remaining, column_height - y);
+            size_t index = column + y * NUM_COLUMNS;
+
+            for (size_t i = 0; i < LENGTH; i++, index += NUM_COLUMNS) {
+                const auto SHIFT = static_cast<unsigned>(index & (VOXELS_PER_WORD - 1)) * bits_per_voxel;
+                words[index >> word_shift] |= PALETTE_INDEX << SHIFT;
+            }
+
+            remaining -= LENGTH;
+            y += LENGTH;
+
+            if (column_height == y) {
+                y = 0;
+                column++;
+            }
+        }
+    }
+}
+
+chisel::types::VoxelID chisel::PaletteStorage::get(const size_t index) const {
+    if (index >= size) throw std::out_of_range("PaletteStorage::get index out of range");
+    return palette[readIndex(words, bits_per_voxel, index)];
+}
+
+void chisel::PaletteStorage::set(const size_t index, const types::VoxelID voxel_id) {
+    if (index >= size) throw std::out_of_range("PaletteStorage::set index out of range");
+
+    const auto it = std::find(palette.begin(), palette.end(), voxel_id);
+    const auto palette_index = static_cast<unsigned>(it - palette.begin());
+
+    if (palette.end() == it) {
+        if (palette.size() == (static_cast<size_t>(1) << bits_per_voxel) and bits_per_voxel < MAX_BITS_PER_VOXEL) {
+            grow();
+        }
+
+        palette.emplace_back(voxel_id);
+        palette_counts.emplace_back(0);
+    }
+
+    palette_counts[readIndex(words, bits_per_voxel, index)]--;
+    palette_counts[palette_index]++;
+    writeIndex(words, bits_per_voxel, index, palette_index);
+}
+
+size_t chisel::PaletteStorage::getCount(const types::VoxelID voxel_id) const {
+    const auto it = std::find(palette.begin(), palette.end(), voxel_id);
+    return palette.end() == it ? 0 : palette_counts[static_cast<size_t>(it - palette.begin())];
+}
+
+// Decodes every voxel a word at a time, much cheaper than a get per voxel
+void chisel::PaletteStorage::copyTo(types::VoxelID* voxel_ids) const {
+    const size_t VOXELS_PER_WORD = WORD_BITS / bits_per_voxel;
+    const uint64_t MASK = (static_cast<uint64_t>(1) << bits_per_voxel) - 1;
+
+    for (size_t word_index = 0, index = 0; word_index < words.size(); word_index++) {
+        uint64_t word = words[word_index];
+
+        for (size_t i = 0; i < VOXELS_PER_WORD and index < size; i++, index++) {
+            voxel_ids[index] = palette[word & MASK];
+            word >>= bits_per_voxel;
+        }
+    }
+}
+
+size_t chisel::PaletteStorage::getMemoryUsage() const {
+    return words.capacity() * sizeof(uint64_t) + palette.capacity() * sizeof(types::VoxelID)
+        + palette_counts.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,56 @@
+#ifndef PALETTE_STORAGE_HPP
+#define PALETTE_STORAGE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#include "block_registry.hpp"
+
+namespace chisel {
+    // length voxels of one ID in a row, along the columns of a chunk or section from bottom to top
+    struct VoxelRun {
+        types::VoxelID voxel_id {};
+        uint32_t length = 0;
+    };
+
+    /*
+     * Fixed number of voxel IDs stored as indices into a palette of the IDs in use.
+     *
+     * Indices take 1, 2, 4, 8 or 16 bits and never straddle a word. Storing an ID the
+     * palette has no room for doubles the index width and repacks every voxel, IDs
+     * are only dropped from the palette when the storage is filled.
+    */
+    class PaletteStorage {
+        std::vector<types::VoxelID> palette {};
+        std::vector<uint32_t> palette_counts {}; // Voxels holding each palette entry
+        std::vector<uint64_t> words {};
+
+        size_t size = 0;
+        unsigned bits_per_voxel = 1;
+
+        [[nodiscard]] static size_t getNumWords(size_t size, unsigned bits_per_voxel);
+        [[nodiscard]] static unsigned getBitsForPaletteSize(size_t palette_size);
+
+        void grow();
+    public:
+        explicit PaletteStorage(size_t size);
+
+        void fill(types::VoxelID voxel_id);
+        void assign(const types::VoxelID* voxel_ids);
+        // Runs walk columns of column_height voxels, voxel y of column c being at index c + y * size / column_height.
+        // The palette holds every ID of the runs, the storage starts out filled with palette[0]
+        void assignColumns(std::vector<types::VoxelID> palette, const std::vector<VoxelRun>& runs, size_t column_height);
+        void copyTo(types::VoxelID* voxel_ids) const;
+
+        [[nodiscard]] types::VoxelID get(size_t index) const;
+        void set(size_t index, types::VoxelID voxel_id);
+
+        // Number of voxels holding voxel_id, kept up to date by every write so no scan is needed
+        [[nodiscard]] size_t getCount(types::VoxelID voxel_id) const;
+
+        [[nodiscard]] size_t getMemoryUsage() const;
+    };
+}
+
+#endif
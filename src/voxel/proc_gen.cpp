@@ -20,13 +20,6 @@ TerrainNoise::TerrainNoise(int seed) : global_seed(seed) {
     node_remap->SetToMax(1.0f);
 
     node_remap->SetClampOutput(true);
-}
-
-void TerrainNoise::getHeightMap(std::array<float, chisel::ChunkDataConstants::CHUNK_AREA>& height_map, const ChunkPosition chunk, const Biome biome) {
-    using chisel::ChunkDataConstants::CHUNK_AREA;
-    using chisel::ChunkDataConstants::CHUNK_SIZE;
-
-    WorldPosition world = Conversion::chunkToWorld(chunk);
 
     node_simplex->SetScale(200.0f);
 
@@ -38,9 +31,46 @@ void TerrainNoise::getHeightMap(std::array<float, chisel::ChunkDataConstants::CH
     node_multiply->SetRHS(0.5f);
     // node_pow_float->SetPow(1.0f);
 
-    auto [min, max] = node_remap->GenUniformGrid2D(
-        height_map.data(),
+    node_cave_simplex = FastNoise::New<FastNoise::Simplex>();
+    node_cave_fractal = FastNoise::New<FastNoise::FractalFBm>();
+
+    node_cave_fractal->SetSource(node_cave_simplex);
+    node_cave_simplex->SetScale(64.0f);
+    node_cave_fractal->SetGain(0.5f);
+    node_cave_fractal->SetOctaveCount(2);
+    node_cave_fractal->SetLacunarity(2.0f);
+}
+
+void TerrainNoise::getHeightMapRegion(std::vector<float>& heights, const ChunkPosition origin, const unsigned num_chunks) {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+
+    const WorldPosition world = Conversion::chunkToWorld(origin);
+    const auto SIDE = static_cast<int>(num_chunks * CHUNK_SIZE);
+    heights.resize(static_cast<size_t>(SIDE * SIDE));
+
+    node_remap->GenUniformGrid2D(
+        heights.data(),
         world.x, world.z,
-        CHUNK_SIZE, CHUNK_SIZE,
+        SIDE, SIDE,
         1.0f, 1.0f, global_seed);
 }
+
+void TerrainNoise::getDensityGrid(std::vector<float>& densities, const WorldPosition origin, const glm::ivec3 num_samples, const float step) {
+    densities.resize(static_cast<size_t>(num_samples.x * num_samples.y * num_samples.z));
+
+    node_cave_fractal->GenUniformGrid3D(
+        densities.data(),
+        static_cast<float>(origin.x), static_cast<float>(origin.y), static_cast<float>(origin.z),
+        num_samples.x, num_samples.y, num_samples.z,
+        step, step, step, global_seed);
+}
+
+void TerrainNoise::sliceHeightMap(const std::vector<float>& heights, const unsigned num_chunks, const unsigned chunk_x, const unsigned chunk_z, HeightMap& height_map) {
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+
+    const size_t SIDE = num_chunks * CHUNK_SIZE;
+    for (unsigned z = 0; z < CHUNK_SIZE; z++) {
+        const auto ROW_BEGIN = heights.begin() + static_cast<std::ptrdiff_t>((chunk_z * CHUNK_SIZE + z) * SIDE + chunk_x * CHUNK_SIZE);
+        std::copy(ROW_BEGIN, ROW_BEGIN + CHUNK_SIZE, height_map.begin() + z * CHUNK_SIZE);
+    }
+}
@@ -1,6 +1,8 @@
 #ifndef PROC_GEN_HPP
 #define PROC_GEN_HPP
 
+#include <array>
+#include <vector>
 #include <unordered_map>
 #include <iostream>
 
@@ -53,6 +55,10 @@ const std::unordered_map<Biome, NoiseParameters> BIOMES_PARAMETERS {
         }
 };
 
+// Terrain heights of one chunk column, rows run along x
+using HeightMap = std::array<float, chisel::ChunkDataConstants::CHUNK_AREA>;
+
+// Owns a FastNoise node graph, use one instance per thread
 class TerrainNoise {
     FastNoise::SmartNode<FastNoise::Simplex> node_simplex;
     FastNoise::SmartNode<FastNoise::FractalFBm> node_fractal;
@@ -61,17 +67,24 @@ class TerrainNoise {
     FastNoise::SmartNode<FastNoise::Remap> node_remap;
     FastNoise::SmartNode<FastNoise::GeneratorCache> node_generator_cache;
 
+    FastNoise::SmartNode<FastNoise::Simplex> node_cave_simplex;
+    FastNoise::SmartNode<FastNoise::FractalFBm> node_cave_fractal;
+
     int global_seed;
 
 public:
     explicit TerrainNoise(int seed);
 
     [[nodiscard]] float getNoise(glm::vec3 any_position, Biome biome);
-    void getHeightMap(std::array<float, chisel::ChunkDataConstants::CHUNK_AREA>& height_map, const ChunkPosition chunk, const Biome biome);
+
+    // Heights of num_chunks x num_chunks chunk columns starting at origin, generated in a single grid
+    void getHeightMapRegion(std::vector<float>& heights, ChunkPosition origin, unsigned num_chunks);
+    // 3D noise in [-1, 1] sampled every step voxels from origin, x varies fastest then y then z
+    void getDensityGrid(std::vector<float>& densities, WorldPosition origin, glm::ivec3 num_samples, float step);
+
+    static void sliceHeightMap(const std::vector<float>& heights, unsigned num_chunks, unsigned chunk_x, unsigned chunk_z, HeightMap& height_map);
 };
 
 [[nodiscard]] unsigned moistureMap(glm::vec3 any_position);
 
-inline TerrainNoise terrain_noise_engine(1);
-
 #endif
@@ -22,9 +22,6 @@ void rayCast(const chisel::ChunkPool& pool, RayCastResult &ray_cast_result, glm:
     float t_delta_x = 0.0f, t_delta_y = 0.0f, t_delta_z = 0.0f;
     float t_max_x = 0.0f, t_max_y = 0.0f, t_max_z = 0.0f;
 
-    LocalPosition voxel_origin;
-    ChunkPosition chunk_position_of_voxel;
-
     if (step_x == 0) {
         t_delta_x = 10000000.0f;
     } else {
@@ -64,31 +61,55 @@ void rayCast(const chisel::ChunkPool& pool, RayCastResult &ray_cast_result, glm:
         }
     }
 
+    using chisel::ChunkDataConstants::CHUNK_SIZE;
+    using chisel::ChunkDataConstants::CHUNK_HEIGHT;
+
+    // The chunk holding the current voxel is only looked up again when the ray leaves it. In between, the
+    // voxel is a bit of a column mask, a step along x or z moves the column index and a step along y the bit
+    const ColumnMask* column_masks = nullptr;
+    LocalPosition local {};
+    unsigned column_index = 0;
+
+    const auto enterChunk = [&] {
+        const Chunk* p_chunk = pool.getLoadedChunk(Conversion::toChunk(current_voxel));
+        column_masks = nullptr != p_chunk ? p_chunk->getColumnMasks().data() : nullptr;
+
+        local = Conversion::toLocal(current_voxel);
+        column_index = local.x + CHUNK_SIZE * local.z;
+    };
+
+    // Steps are applied to unsigned coordinates, leaving the chunk on either side makes them CHUNK_SIZE or more
+    const auto stepColumn = [&](unsigned& coordinate, const int step, const unsigned stride) {
+        coordinate += static_cast<unsigned>(step);
+
+        if (coordinate >= CHUNK_SIZE) enterChunk();
+        else column_index += static_cast<unsigned>(step) * stride;
+    };
+
+    enterChunk();
+
     unsigned voxel_traversed = 0;
     float current_ray_length = 0.0f;
 
     while (voxel_traversed <= chisel::EngineConstants::MAX_VOXEL_TRAVERSED or current_ray_length <= chisel::EngineConstants::MAX_RAY_LENGTH) {
-        chunk_position_of_voxel = Conversion::toChunk(current_voxel);
-
-        if (pool.isPositionUsed(chunk_position_of_voxel)) {
-            voxel_origin = Conversion::toLocal(current_voxel, chunk_position_of_voxel);
-
-            if (not pool.isVoidAtInChunk(voxel_origin, chunk_position_of_voxel)) {
-                ray_cast_result.is_detected_voxel = true;
-                ray_cast_result.detected_voxel_position = current_voxel;
-                break;
-            }
+        // Chunks not loaded yet, or still generating, let the ray through
+        if (nullptr != column_masks and (column_masks[column_index] >> local.y & 1)) {
+            ray_cast_result.is_detected_voxel = true;
+            ray_cast_result.detected_voxel_position = current_voxel;
+            break;
         }
 
         if (t_max_x < t_max_y) {
             if (t_max_x < t_max_z) {
                 t_max_x += t_delta_x;
                 current_voxel.x += step_x;
+                stepColumn(local.x, step_x, 1);
                 ray_cast_result.detected_face = face_x;
                 current_ray_length = t_max_x;
             } else {
                 t_max_z += t_delta_z;
                 current_voxel.z += step_z;
+                stepColumn(local.z, step_z, CHUNK_SIZE);
                 ray_cast_result.detected_face = face_z;
                 current_ray_length = t_max_z;
             }
@@ -96,11 +117,14 @@ void rayCast(const chisel::ChunkPool& pool, RayCastResult &ray_cast_result, glm:
             if (t_max_y < t_max_z) {
                 t_max_y += t_delta_y;
                 current_voxel.y += step_y;
+                local.y += static_cast<unsigned>(step_y);
+                if (local.y >= CHUNK_HEIGHT) enterChunk();
                 ray_cast_result.detected_face = face_y;
                 current_ray_length = t_max_y;
             } else {
                 t_max_z += t_delta_z;
                 current_voxel.z += step_z;
+                stepColumn(local.z, step_z, CHUNK_SIZE);
                 ray_cast_result.detected_face = face_z;
                 current_ray_length = t_max_z;
             }
@@ -118,57 +142,55 @@ WorldPosition getAdjacentVoxel(const RayCastResult &ray_cast_result) {
 
 void breakBlock(chisel::ChunkPool& pool, const WorldPosition voxel_position) {
     const auto chunk_position = Conversion::toChunk(voxel_position);
-    const auto local_position = Conversion::toLocal(voxel_position, chunk_position);
+    const auto local_position = Conversion::toLocal(voxel_position);
 
     pool.setVoxelIDAtPositionInChunk(0, local_position, chunk_position);
-    pool.enqueueForRebuilding(chunk_position);
+    pool.enqueueForEditRebuilding(chunk_position);
 
     if (isVoxelAtChunkBoundarySouth(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South));
     } else if (isVoxelAtChunkBoundaryNorth(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North));
     }
 
     if (isVoxelAtChunkBoundaryBottom(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom));
     } else if (isVoxelAtChunkBoundaryTop(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top));
     }
 
     if (isVoxelAtChunkBoundaryWest(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::West));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::West));
     } else if (isVoxelAtChunkBoundaryEast(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::East));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::East));
     }
 }
 
 void placeBlock(chisel::ChunkPool& pool, const WorldPosition adjacent_voxel_position, chisel::types::VoxelID block_id) {
     const auto chunk_position = Conversion::toChunk(adjacent_voxel_position);
-    const auto local_position = Conversion::toLocal(adjacent_voxel_position, chunk_position);
+    const auto local_position = Conversion::toLocal(adjacent_voxel_position);
 
     // auto& registry = chisel::BlockRegistry::getInstance();
     // auto tnt_id = registry.getDefinition("chisel::dirt").voxel_id;
 
-    if (chunk_position.y != 0) return;
-
     pool.setVoxelIDAtPositionInChunk(block_id, local_position, chunk_position);
-    pool.enqueueForRebuilding(chunk_position);
+    pool.enqueueForEditRebuilding(chunk_position);
 
     if (isVoxelAtChunkBoundarySouth(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::South));
     } else if (isVoxelAtChunkBoundaryNorth(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::North));
     }
 
     if (isVoxelAtChunkBoundaryBottom(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Bottom));
     } else if (isVoxelAtChunkBoundaryTop(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::Top));
     }
 
     if (isVoxelAtChunkBoundaryWest(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::West));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::West));
     } else if (isVoxelAtChunkBoundaryEast(local_position)) {
-        pool.enqueueForRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::East));
+        pool.enqueueForEditRebuilding(chunk_position + CHUNK_NEIGHBORS_DIRECTION.at(Direction::East));
     }
 }
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "region_file.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace chisel::RegionConstants;
+
+constexpr size_t TABLE_OFFSET = 2 * sizeof(uint32_t);
+constexpr size_t HEADER_SIZE = (TABLE_OFFSET + NUM_REGION_ENTRIES * sizeof(chisel::RegionEntry) + SECTOR_SIZE - 1) / SECTOR_SIZE * SECTOR_SIZE;
+
+size_t toSectors(const size_t size) {
+    return (size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+}
+
+chisel::RegionFile::RegionFile(const std::filesystem::path& path) {
+    entries.resize(NUM_REGION_ENTRIES);
+    if (not open(path)) return;
+
+    // A new file only gets its empty header
+    if (0 == file_size) {
+        is_valid = writeHeader();
+        return;
+    }
+
+    if (readHeader(path)) {
+        is_valid = true;
+        return;
+    }
+
+    // Every save into the region would fail on an unreadable file, it is kept aside and a new one takes its place
+    std::filesystem::path stale_path = path;
+    stale_path += ".old";
+
+    close();
+    std::error_code error {};
+    std::filesystem::rename(path, stale_path, error);
+
+    if (error or not open(path)) {
+        std::cerr << "WARNING :: Cannot replace region file " << path.string() << '\n';
+        return;
+    }
+
+    std::cerr << "WARNING :: Region file moved to " << stale_path.string() << ", its chunks are regenerated" << '\n';
+    is_valid = 0 == file_size and writeHeader();
+}
+
+chisel::RegionFile::~RegionFile() {
+    sync();
+    close();
+}
+
+bool chisel::RegionFile::open(const std::filesystem::path& path) {
+    #ifdef _WIN32
+    file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        std::cerr << "WARNING :: Cannot open region file " << path.string() << '\n';
+        return false;
+    }
+
+    LARGE_INTEGER size {};
+    GetFileSizeEx(file, &size);
+    file_size = static_cast<size_t>(size.QuadPart);
+    #else
+    file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) {
+        std::cerr << "WARNING :: Cannot open region file " << path.string() << '\n';
+        return false;
+    }
+
+    struct stat status {};
+    fstat(file, &status);
+    file_size = static_cast<size_t>(status.st_size);
+    #endif
+
+    return true;
+}
+
+void chisel::RegionFile::close() {
+    unmap();
+
+    #ifdef _WIN32
+    if (INVALID_HANDLE_VALUE != file) CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+    #else
+    if (file >= 0) ::close(file);
+    file = -1;
+    #endif
+}
+
+bool chisel::RegionFile::writeHeader() {
+    std::vector<uint8_t> header(HEADER_SIZE, 0);
+    std::memcpy(header.data(), &REGION_MAGIC, sizeof(uint32_t));
+    std::memcpy(header.data() + sizeof(uint32_t), &REGION_VERSION, sizeof(uint32_t));
+
+    if (not writeAt(0, header.data(), header.size())) return false;
+
+    file_size = HEADER_SIZE;
+    used_sectors.assign(toSectors(HEADER_SIZE), true);
+    return true;
+}
+
+bool chisel::RegionFile::readHeader(const std::filesystem::path& path) {
+    if (file_size < HEADER_SIZE or not map()) {
+        std::cerr << "WARNING :: Truncated region file " << path.string() << '\n';
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0;
+    std::memcpy(&magic, mapped_bytes, sizeof(uint32_t));
+    std::memcpy(&version, mapped_bytes + sizeof(uint32_t), sizeof(uint32_t));
+
+    if (REGION_MAGIC != magic or REGION_VERSION != version) {
+        std::cerr << "WARNING :: Region file of an unknown format " << path.string() << '\n';
+        return false;
+    }
+
+    std::memcpy(entries.data(), mapped_bytes + TABLE_OFFSET, NUM_REGION_ENTRIES * sizeof(RegionEntry));
+
+    // Entries read would reject are left out, their sectors are free for the next writes
+    used_sectors.assign(toSectors(file_size), false);
+    markSectors(0, toSectors(HEADER_SIZE), true);
+
+    for (RegionEntry& entry : entries) {
+        if (0 == entry.offset) continue;
+
+        if (entry.offset < HEADER_SIZE or 0 != entry.offset % SECTOR_SIZE or static_cast<size_t>(entry.offset) + entry.size > file_size) {
+            entry = {};
+            continue;
+        }
+
+        markSectors(entry.offset / SECTOR_SIZE, toSectors(entry.size), true);
+    }
+
+    return true;
+}
+
+bool chisel::RegionFile::writeAt(const size_t offset, const void* data, const size_t size) {
+    #ifdef _WIN32
+    OVERLAPPED overlapped {};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+
+    DWORD num_written = 0;
+    return WriteFile(file, data, static_cast<DWORD>(size), &num_written, &overlapped) and num_written == size;
+    #else
+    const auto* p_data = static_cast<const uint8_t*>(data);
+    size_t num_written = 0;
+
+    while (num_written < size) {
+        const ssize_t RESULT = pwrite(file, p_data + num_written, size - num_written, static_cast<off_t>(offset + num_written));
+        if (RESULT <= 0) return false;
+        num_written += static_cast<size_t>(RESULT);
+    }
+
+    return true;
+    #endif
+}
+
+void chisel::RegionFile::markSectors(const size_t first_sector, const size_t num_sectors, const bool is_used) {
+    if (first_sector + num_sectors > used_sectors.size()) used_sectors.resize(first_sector + num_sectors, false);
+    std::fill_n(used_sectors.begin() + static_cast<std::ptrdiff_t>(first_sector), num_sectors, is_used);
+}
+
+// First fit, a free run at the end of the file may be extended past it
+size_t chisel::RegionFile::findFreeSectors(const size_t num_sectors) const {
+    size_t run_start = 0;
+    size_t run_length = 0;
+
+    for (size_t sector = 0; sector < used_sectors.size(); sector++) {
+        if (used_sectors[sector]) {
+            run_length = 0;
+            continue;
+        }
+
+        if (0 == run_length) run_start = sector;
+        if (++run_length == num_sectors) return run_start;
+    }
+
+    return 0 == run_length ? used_sectors.size() : run_start;
+}
+
+bool chisel::RegionFile::map() {
+    unmap();
+
+    #ifdef _WIN32
+    mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping) return false;
+
+    mapped_bytes = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == mapped_bytes) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+        return false;
+    }
+    #else
+    void* address = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, file, 0);
+    if (MAP_FAILED == address) return false;
+
+    mapped_bytes = static_cast<const uint8_t*>(address);
+    #endif
+
+    mapped_size = file_size;
+    return true;
+}
+
+void chisel::RegionFile::unmap() {
+    if (nullptr == mapped_bytes) return;
+
+    #ifdef _WIN32
+    UnmapViewOfFile(mapped_bytes);
+    CloseHandle(mapping);
+    mapping = nullptr;
+    #else
+    munmap(const_cast<uint8_t*>(mapped_bytes), mapped_size);
+    #endif
+
+    mapped_bytes = nullptr;
+    mapped_size = 0;
+}
+
+void chisel::RegionFile::sync() {
+    if (is_synced) return;
+
+    #ifdef _WIN32
+    FlushFileBuffers(file);
+    #else
+    fsync(file);
+    #endif
+
+    is_synced = true;
+}
+
+bool chisel::RegionFile::isValid() const {
+    return is_valid;
+}
+
+bool chisel::RegionFile::read(const unsigned index, const uint8_t*& bytes, size_t& size) {
+    if (not is_valid or index >= NUM_REGION_ENTRIES) return false;
+
+    const RegionEntry ENTRY = entries[index];
+    if (0 == ENTRY.offset or static_cast<size_t>(ENTRY.offset) + ENTRY.size > file_size) return false;
+
+    if (static_cast<size_t>(ENTRY.offset) + ENTRY.size > mapped_size and not map()) return false;
+
+    bytes = mapped_bytes + ENTRY.offset;
+    size = ENTRY.size;
+    return true;
+}
+
+bool chisel::RegionFile::write(const unsigned index, const std::vector<uint8_t>& bytes) {
+    if (not is_valid or index >= NUM_REGION_ENTRIES or bytes.empty()) return false;
+
+    is_synced = false;
+
+    RegionEntry& entry = entries[index];
+    const size_t OLD_FIRST_SECTOR = entry.offset / SECTOR_SIZE;
+    const size_t OLD_NUM_SECTORS = 0 != entry.offset ? toSectors(entry.size) : 0;
+    const size_t NUM_SECTORS = toSectors(bytes.size());
+    const bool FITS_IN_PLACE = NUM_SECTORS <= OLD_NUM_SECTORS;
+
+    RegionEntry new_entry {};
+    new_entry.size = static_cast<uint32_t>(bytes.size());
+
+    if (FITS_IN_PLACE) {
+        if (not writeAt(entry.offset, bytes.data(), bytes.size())) return false;
+        new_entry.offset = entry.offset;
+    } else {
+        // The old sectors stay in use until the table points elsewhere, a failed write leaves the chunk readable
+        const size_t FIRST_SECTOR = findFreeSectors(NUM_SECTORS);
+        const size_t OFFSET = FIRST_SECTOR * SECTOR_SIZE;
+        const size_t END = OFFSET + NUM_SECTORS * SECTOR_SIZE;
+        if (END > UINT32_MAX) return false;
+
+        if (END > file_size) {
+            // Padded to whole sectors so the end of the file stays aligned, growing a mapped file is not allowed on every platform
+            std::vector<uint8_t> padded(END - OFFSET, 0);
+            std::memcpy(padded.data(), bytes.data(), bytes.size());
+
+            unmap();
+            if (not writeAt(OFFSET, padded.data(), padded.size())) return false;
+            file_size = END;
+        } else if (not writeAt(OFFSET, bytes.data(), bytes.size())) {
+            return false;
+        }
+
+        new_entry.offset = static_cast<uint32_t>(OFFSET);
+        markSectors(FIRST_SECTOR, NUM_SECTORS, true);
+    }
+
+    if (not writeAt(TABLE_OFFSET + index * sizeof(RegionEntry), &new_entry, sizeof(RegionEntry))) return false;
+    entry = new_entry;
+
+    // Only the tail is freed when the chunk shrank in place, all of its old sectors when it moved
+    if (FITS_IN_PLACE) {
+        markSectors(OLD_FIRST_SECTOR + NUM_SECTORS, OLD_NUM_SECTORS - NUM_SECTORS, false);
+    } else {
+        markSectors(OLD_FIRST_SECTOR, OLD_NUM_SECTORS, false);
+    }
+
+    return true;
+}
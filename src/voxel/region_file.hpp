@@ -0,0 +1,100 @@
+#ifndef REGION_FILE_HPP
+#define REGION_FILE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace chisel::RegionConstants {
+    // A region holds 32x32 chunk columns, 4 chunks tall
+    constexpr unsigned REGION_SHIFT = 5;
+    constexpr unsigned REGION_HEIGHT_SHIFT = 2;
+    constexpr unsigned REGION_SIZE = 1 << REGION_SHIFT;
+    constexpr unsigned REGION_HEIGHT = 1 << REGION_HEIGHT_SHIFT;
+    constexpr unsigned NUM_REGION_ENTRIES = REGION_SIZE * REGION_SIZE * REGION_HEIGHT;
+
+    constexpr uint32_t REGION_MAGIC = 0x47524843; // "CHRG"
+    constexpr uint32_t REGION_VERSION = 1;
+
+    // Chunk data is laid out in whole sectors so a chunk that shrinks or grows a little is rewritten in place
+    constexpr size_t SECTOR_SIZE = 512;
+}
+
+namespace chisel {
+    struct RegionEntry {
+        uint32_t offset = 0; // In bytes from the start of the file, 0 when the chunk was never saved
+        uint32_t size = 0;
+    };
+
+    /*
+     * One region file: a header with the offset of every chunk of the region,
+     * followed by the chunk data.
+     *
+     * The file is memory-mapped for reading, so loading a chunk is a lookup in
+     * the table and a read straight out of the mapping. Writes go through the
+     * file handle, a chunk that outgrew its sectors moves to the first run of
+     * free sectors large enough for it, or to the end of the file when there is
+     * none, and the mapping is refreshed on the next read.
+     *
+     * Which sectors are in use is kept in memory only, it is rebuilt from the
+     * table when the file is opened, so sectors freed by moved or shrunk chunks
+     * are reused across sessions too.
+     *
+     * A truncated file or one of another format is renamed with an .old suffix
+     * and replaced by an empty region, so its chunks are regenerated and saved
+     * again instead of being lost on every save.
+    */
+    class RegionFile {
+        #ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        #else
+        int file = -1;
+        #endif
+
+        const uint8_t* mapped_bytes = nullptr;
+        size_t mapped_size = 0;
+        size_t file_size = 0;
+
+        std::vector<RegionEntry> entries {};
+        std::vector<bool> used_sectors {};
+        bool is_valid = false;
+        bool is_synced = true;
+
+        [[nodiscard]] bool open(const std::filesystem::path& path);
+        void close();
+
+        [[nodiscard]] bool writeHeader();
+        [[nodiscard]] bool readHeader(const std::filesystem::path& path);
+        [[nodiscard]] bool writeAt(size_t offset, const void* data, size_t size);
+        void markSectors(size_t first_sector, size_t num_sectors, bool is_used);
+        [[nodiscard]] size_t findFreeSectors(size_t num_sectors) const;
+        [[nodiscard]] bool map();
+        void unmap();
+    public:
+        explicit RegionFile(const std::filesystem::path& path);
+        ~RegionFile();
+
+        [[nodiscard]] bool isValid() const;
+
+        // The returned bytes stay valid until the next write to this file
+        [[nodiscard]] bool read(unsigned index, const uint8_t*& bytes, size_t& size);
+        [[nodiscard]] bool write(unsigned index, const std::vector<uint8_t>& bytes);
+
+        // Waits for every write so far to reach the disk
+        void sync();
+
+        RegionFile(const RegionFile&)            = delete;
+        RegionFile& operator=(const RegionFile&) = delete;
+        RegionFile(RegionFile&&)                 = delete;
+        RegionFile& operator=(RegionFile&&)      = delete;
+    };
+}
+
+#endif
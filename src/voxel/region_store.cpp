@@ -0,0 +1,196 @@
+#include "region_store.hpp"
+
+#include <chrono>
+#include <algorithm>
+
+using namespace chisel::RegionConstants;
+
+constexpr size_t MAX_OPEN_REGION_FILES = 32;
+// Saves are gathered this long before a batch is written, so one sync covers many of them
+constexpr std::chrono::milliseconds SAVE_BATCH_INTERVAL { 500 };
+
+glm::ivec3 toRegion(const ChunkPosition chunk) {
+    return { chunk.x >> REGION_SHIFT, chunk.y >> REGION_HEIGHT_SHIFT, chunk.z >> REGION_SHIFT };
+}
+
+unsigned toRegionIndex(const ChunkPosition chunk) {
+    const auto x = static_cast<unsigned>(chunk.x) & (REGION_SIZE - 1);
+    const auto y = static_cast<unsigned>(chunk.y) & (REGION_HEIGHT - 1);
+    const auto z = static_cast<unsigned>(chunk.z) & (REGION_SIZE - 1);
+
+    return x | z << REGION_SHIFT | y << (2 * REGION_SHIFT);
+}
+
+chisel::RegionStore::RegionStore(std::filesystem::path directory) : directory(std::move(directory)) {
+    std::error_code error {};
+    std::filesystem::create_directories(this->directory, error);
+
+    if (error) {
+        std::cerr << "WARNING :: Cannot create world directory " << this->directory.string() << ", nothing will be saved" << '\n';
+    }
+
+    save_thread = std::thread(&RegionStore::work, this);
+}
+
+// Queued saves are still written before the thread exits
+chisel::RegionStore::~RegionStore() {
+    {
+        const std::lock_guard lock(saves_mutex);
+        is_stopping = true;
+    }
+
+    saves_condition.notify_all();
+    save_thread.join();
+}
+
+std::filesystem::path chisel::RegionStore::getRegionPath(const glm::ivec3 region) const {
+    return directory / ("r." + std::to_string(region.x) + '.' + std::to_string(region.y) + '.' + std::to_string(region.z) + ".region");
+}
+
+// Regions without a file are remembered as such, so unexplored areas do not hit the file system on every load
+chisel::RegionFile* chisel::RegionStore::getRegionFile(const glm::ivec3 region, const bool is_created) {
+    auto it = regions.find(region);
+
+    if (regions.end() == it) {
+        if (regions.size() >= MAX_OPEN_REGION_FILES) closeLeastRecentlyUsed();
+
+        const std::filesystem::path PATH = getRegionPath(region);
+        std::error_code error {};
+
+        it = regions.try_emplace(region).first;
+        if (std::filesystem::exists(PATH, error)) it->second.file = std::make_unique<RegionFile>(PATH);
+    }
+
+    OpenRegion& open_region = it->second;
+    open_region.last_use = ++num_uses;
+
+    if (nullptr == open_region.file and is_created) {
+        open_region.file = std::make_unique<RegionFile>(getRegionPath(region));
+    }
+
+    if (nullptr == open_region.file or not open_region.file->isValid()) return nullptr;
+    return open_region.file.get();
+}
+
+void chisel::RegionStore::closeLeastRecentlyUsed() {
+    const auto OLDEST = std::min_element(regions.begin(), regions.end(), [](const auto& a, const auto& b) {
+        return a.second.last_use < b.second.last_use;
+    });
+
+    if (regions.end() != OLDEST) regions.erase(OLDEST);
+}
+
+bool chisel::RegionStore::findQueuedSave(const ChunkPosition position, ChunkSaveData& save_data) {
+    const std::lock_guard lock(saves_mutex);
+
+    auto it = queued_saves.find(position);
+    if (queued_saves.end() == it) {
+        it = written_saves.find(position);
+        if (written_saves.end() == it) return false;
+    }
+
+    save_data = it->second;
+    return true;
+}
+
+bool chisel::RegionStore::load(const ChunkPosition position, Chunk& chunk) {
+    // A save the thread has not written yet is newer than anything in the region file
+    if (ChunkSaveData queued_save {}; findQueuedSave(position, queued_save)) {
+        chunk.restore(std::move(queued_save));
+        return true;
+    }
+
+    const std::lock_guard lock(regions_mutex);
+
+    RegionFile* region_file = getRegionFile(toRegion(position), false);
+    if (nullptr == region_file) return false;
+
+    const uint8_t* bytes = nullptr;
+    size_t size = 0;
+    if (not region_file->read(toRegionIndex(position), bytes, size)) return false;
+
+    if (not chunk.deserialize(bytes, size)) {
+        std::cerr << "WARNING :: Corrupted chunk " << position.x << ' ' << position.y << ' ' << position.z << " is regenerated" << '\n';
+        return false;
+    }
+
+    return true;
+}
+
+// Copied here so the chunk can be reset and reused right away, encoding is left to the save thread
+void chisel::RegionStore::save(const ChunkPosition position, const Chunk& chunk) {
+    ChunkSaveData save_data = chunk.getSaveData();
+
+    {
+        const std::lock_guard lock(saves_mutex);
+        queued_saves.insert_or_assign(position, std::move(save_data));
+    }
+
+    saves_condition.notify_one();
+}
+
+void chisel::RegionStore::flush() {
+    std::unique_lock lock(saves_mutex);
+    is_flush_requested = true;
+    saves_condition.notify_one();
+
+    flushed_condition.wait(lock, [this] { return queued_saves.empty() and written_saves.empty(); });
+    is_flush_requested = false;
+}
+
+// Chunks are encoded outside the regions lock, so the terrain workers only wait on the writes
+void chisel::RegionStore::writeSaves(const SaveBatch& saves) {
+    std::vector<glm::ivec3> written_regions {};
+    std::vector<uint8_t> bytes {};
+
+    for (auto const& [position, save_data] : saves) {
+        bytes.clear();
+        save_data.serialize(bytes);
+
+        const glm::ivec3 REGION = toRegion(position);
+        const std::lock_guard lock(regions_mutex);
+
+        RegionFile* region_file = getRegionFile(REGION, true);
+        if (nullptr == region_file or not region_file->write(toRegionIndex(position), bytes)) {
+            std::cerr << "WARNING :: Cannot save chunk " << position.x << ' ' << position.y << ' ' << position.z << '\n';
+            continue;
+        }
+
+        if (std::find(written_regions.begin(), written_regions.end(), REGION) == written_regions.end()) {
+            written_regions.push_back(REGION);
+        }
+    }
+
+    const std::lock_guard lock(regions_mutex);
+
+    // Files closed while the batch was written have synced themselves
+    for (const glm::ivec3 region : written_regions) {
+        const auto it = regions.find(region);
+        if (regions.end() != it and nullptr != it->second.file) it->second.file->sync();
+    }
+}
+
+// Only this thread changes written_saves, so it reads the batch without the lock
+void chisel::RegionStore::work() {
+    while (true) {
+        SaveBatch finished_saves {};
+
+        {
+            std::unique_lock lock(saves_mutex);
+            saves_condition.wait(lock, [this] { return is_stopping or not queued_saves.empty(); });
+            if (queued_saves.empty()) return;
+
+            saves_condition.wait_for(lock, SAVE_BATCH_INTERVAL, [this] { return is_stopping or is_flush_requested; });
+            written_saves.swap(queued_saves);
+        }
+
+        writeSaves(written_saves);
+
+        {
+            const std::lock_guard lock(saves_mutex);
+            finished_saves.swap(written_saves);
+            if (queued_saves.empty()) flushed_condition.notify_all();
+        }
+        // The batch is freed here, outside the lock the render thread saves under
+    }
+}
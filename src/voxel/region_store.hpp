@@ -0,0 +1,83 @@
+#ifndef REGION_STORE_HPP
+#define REGION_STORE_HPP
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+#include <condition_variable>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include "chunk.hpp"
+#include "region_file.hpp"
+
+namespace chisel {
+    struct OpenRegion {
+        std::unique_ptr<RegionFile> file {}; // Null when there is no file for the region yet
+        uint64_t last_use = 0;
+    };
+
+    // Chunks waiting for the save thread
+    using SaveBatch = std::unordered_map<ChunkPosition, ChunkSaveData>;
+
+    /*
+     * Saved chunks of a world, one region file per REGION_SIZE x REGION_SIZE x
+     * REGION_HEIGHT chunks.
+     *
+     * Region files are opened on first use and kept open, the least recently
+     * used one is closed past MAX_OPEN_REGION_FILES. Safe to share between the
+     * render thread and the terrain workers.
+     *
+     * Saving only copies the chunk's save data into a queue, a save thread
+     * encodes and writes it behind the caller in batches and syncs every
+     * region file it touched once per batch. A chunk saved again before it
+     * was written replaces its earlier copy in the queue. Loads look at the queued and the
+     * written batch first, so a chunk always comes back as it was last saved.
+    */
+    class RegionStore {
+        std::filesystem::path directory;
+
+        std::mutex regions_mutex {};
+        std::unordered_map<glm::ivec3, OpenRegion> regions {};
+        uint64_t num_uses = 0;
+
+        std::mutex saves_mutex {};
+        std::condition_variable saves_condition {};
+        std::condition_variable flushed_condition {};
+        SaveBatch queued_saves {};
+        SaveBatch written_saves {}; // Taken by the save thread, readable until they are on disk
+        bool is_flush_requested = false;
+        bool is_stopping = false;
+
+        std::thread save_thread;
+
+        [[nodiscard]] std::filesystem::path getRegionPath(glm::ivec3 region) const;
+        [[nodiscard]] RegionFile* getRegionFile(glm::ivec3 region, bool is_created);
+        void closeLeastRecentlyUsed();
+
+        [[nodiscard]] bool findQueuedSave(ChunkPosition, ChunkSaveData&);
+        void writeSaves(const SaveBatch&);
+        void work();
+    public:
+        explicit RegionStore(std::filesystem::path directory);
+        ~RegionStore();
+
+        // Chunks are read directly from the mapped region, false when the chunk was never saved
+        [[nodiscard]] bool load(ChunkPosition, Chunk&);
+        // Never waits on the disk, the chunk is free to be reused as soon as this returns
+        void save(ChunkPosition, const Chunk&);
+        // Waits until every save so far is written and synced
+        void flush();
+
+        RegionStore(const RegionStore&)            = delete;
+        RegionStore& operator=(const RegionStore&) = delete;
+        RegionStore(RegionStore&&)                 = delete;
+        RegionStore& operator=(RegionStore&&)      = delete;
+    };
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "terrain_worker_pool.hpp"
+
+chisel::TerrainWorkerPool::TerrainWorkerPool(const unsigned num_workers, RegionStore& region_store) : region_store(region_store) {
+    workers.reserve(num_workers);
+
+    for (unsigned i = 0; i < num_workers; i++) {
+        workers.emplace_back(&TerrainWorkerPool::work, this);
+    }
+}
+
+chisel::TerrainWorkerPool::~TerrainWorkerPool() {
+    {
+        const std::lock_guard lock(jobs_mutex);
+        is_stopping = true;
+    }
+
+    jobs_condition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void chisel::TerrainWorkerPool::work() {
+    // FastNoise graphs are not shared between threads, each worker builds its own
+    TerrainNoise terrain_noise { EngineConstants::WORLD_SEED };
+    HeightMap height_map {};
+
+    while (true) {
+        TerrainJob job {};
+
+        {
+            std::unique_lock lock(jobs_mutex);
+            jobs_condition.wait(lock, [this] { return is_stopping or not jobs.empty(); });
+            if (is_stopping) return;
+
+            job = std::move(jobs.front());
+            jobs.pop();
+        }
+
+        const bool IS_SAVED = region_store.load(job.position, *job.chunk);
+
+        // A saved delta holds the edits only, the terrain under them is generated again
+        if (not IS_SAVED or ChunkPersistence::Delta == job.chunk->getPersistence()) {
+            height_maps.getHeightMap(terrain_noise, job.position, height_map);
+
+            if constexpr (EngineConstants::IS_CAVE_GENERATION_ENABLED) {
+                job.chunk->buildDensityVoxels(height_map, terrain_noise);
+            } else {
+                job.chunk->buildVoxels(height_map);
+            }
+        }
+
+        if (IS_SAVED) {
+            job.chunk->replayEdits();
+        } else if constexpr (not EngineConstants::IS_DELTA_PERSISTENCE_ENABLED) {
+            // Saved whole when recycled, so coming back reads it instead of generating it again
+            job.chunk->setPersistence(ChunkPersistence::Snapshot);
+            job.chunk->setDirty(true);
+        }
+
+        const std::lock_guard lock(results_mutex);
+        results.emplace(std::move(job));
+    }
+}
+
+void chisel::TerrainWorkerPool::submit(TerrainJob &&job) {
+    {
+        const std::lock_guard lock(jobs_mutex);
+        jobs.emplace(std::move(job));
+    }
+
+    num_jobs_in_flight++;
+    jobs_condition.notify_one();
+}
+
+bool chisel::TerrainWorkerPool::tryPopResult(TerrainResult &result) {
+    const std::lock_guard lock(results_mutex);
+    if (results.empty()) return false;
+
+    result = std::move(results.front());
+    results.pop();
+    num_jobs_in_flight--;
+
+    return true;
+}
+
+size_t chisel::TerrainWorkerPool::getNumJobsInFlight() const {
+    return num_jobs_in_flight;
+}
+
+size_t chisel::TerrainWorkerPool::getNumWorkers() const {
+    return workers.size();
+}
@@ -0,0 +1,66 @@
+#ifndef TERRAIN_WORKER_POOL_HPP
+#define TERRAIN_WORKER_POOL_HPP
+
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "chunk.hpp"
+#include "region_store.hpp"
+#include "height_map_cache.hpp"
+
+namespace chisel {
+    struct TerrainJob {
+        size_t chunk_id {};
+        ChunkPosition position {};
+        ChunkPtr chunk {};
+    };
+
+    using TerrainResult = TerrainJob;
+
+    /*
+     * Fills chunks with terrain away from the render thread.
+     *
+     * A job owns its chunk until the result is popped, so nothing else can
+     * see the voxels while they are being written. Chunks saved before are
+     * read back from their region, the others are generated. Every worker
+     * configures its own noise graph, only the heightmap regions are shared.
+    */
+    class TerrainWorkerPool {
+        std::vector<std::thread> workers {};
+
+        std::mutex jobs_mutex {};
+        std::condition_variable jobs_condition {};
+        std::queue<TerrainJob> jobs {};
+        bool is_stopping = false;
+
+        std::mutex results_mutex {};
+        std::queue<TerrainResult> results {};
+
+        HeightMapCache height_maps {};
+        RegionStore& region_store;
+
+        // Only touched by the thread submitting jobs and popping results
+        size_t num_jobs_in_flight = 0;
+
+        void work();
+    public:
+         TerrainWorkerPool(unsigned num_workers, RegionStore&);
+        ~TerrainWorkerPool();
+
+        void submit(TerrainJob &&job);
+        [[nodiscard]] bool tryPopResult(TerrainResult &result);
+
+        [[nodiscard]] size_t getNumJobsInFlight() const;
+        [[nodiscard]] size_t getNumWorkers() const;
+
+        TerrainWorkerPool(const TerrainWorkerPool&)            = delete;
+        TerrainWorkerPool& operator=(const TerrainWorkerPool&) = delete;
+        TerrainWorkerPool(TerrainWorkerPool&&)                 = delete;
+        TerrainWorkerPool& operator=(TerrainWorkerPool&&)      = delete;
+    };
+}
+
+#endif
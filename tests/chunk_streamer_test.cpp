@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <vector>
+#include <unordered_set>
+
+#include "chunk_streamer.hpp"
+
+/*
+ * Moves the streamer center and checks the pending loads against the window.
+ *
+ * Nothing is loaded in between, so after every move the queue must hold each
+ * position of the new window exactly once, ordered farthest first from the
+ * new center.
+*/
+
+int getSquaredDistanceTo(const ChunkPosition a, const ChunkPosition b) {
+    const ChunkPosition D = a - b;
+    return D.x * D.x + D.y * D.y + D.z * D.z;
+}
+
+bool checkPendingLoads(const chisel::ChunkStreamer& streamer, const ChunkPosition center) {
+    const chisel::ChunkWindow WINDOW = chisel::ChunkWindow::around(center);
+    const std::vector<ChunkPosition>& pending_loads = streamer.getPendingLoads();
+
+    const auto WINDOW_VOLUME = static_cast<size_t>((WINDOW.x_max - WINDOW.x_min + 1) * (WINDOW.y_max - WINDOW.y_min + 1) * (WINDOW.z_max - WINDOW.z_min + 1));
+    if (WINDOW_VOLUME != pending_loads.size()) {
+        std::fprintf(stderr, "Center %d %d %d: %zu pending loads for a window of %zu chunks\n", center.x, center.y, center.z, pending_loads.size(), WINDOW_VOLUME);
+        return false;
+    }
+
+    std::unordered_set<ChunkPosition> queued {};
+
+    for (size_t i = 0; i < pending_loads.size(); i++) {
+        const ChunkPosition POSITION = pending_loads[i];
+
+        if (not WINDOW.contains(POSITION) or not queued.insert(POSITION).second) {
+            std::fprintf(stderr, "Center %d %d %d: %d %d %d is outside the window or queued twice\n", center.x, center.y, center.z, POSITION.x, POSITION.y, POSITION.z);
+            return false;
+        }
+
+        if (i > 0 and getSquaredDistanceTo(pending_loads[i - 1], center) < getSquaredDistanceTo(POSITION, center)) {
+            std::fprintf(stderr, "Center %d %d %d: %d %d %d is queued after a nearer chunk\n", center.x, center.y, center.z, POSITION.x, POSITION.y, POSITION.z);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    chisel::ChunkPool pool {};
+    chisel::ChunkStreamer streamer { pool };
+
+    // One chunk along each axis, then diagonally and back across the origin
+    const std::vector<ChunkPosition> CENTERS {
+        { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, -1, 0 }, { -3, 2, 4 }
+    };
+
+    for (const ChunkPosition& center : CENTERS) {
+        streamer.setCenter(center);
+        if (not checkPendingLoads(streamer, center)) return 1;
+    }
+
+    std::printf("Pending loads ordered around %zu centers\n", CENTERS.size());
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <cstdio>
+#include <vector>
+#include <filesystem>
+
+#include "region_file.hpp"
+
+/*
+ * Grows, shrinks and moves chunks in a region file and checks that sectors
+ * they freed are written again before the file grows, in the same session and
+ * after the file is reopened. Every chunk written is read back at the end.
+*/
+
+using chisel::RegionConstants::SECTOR_SIZE;
+
+constexpr unsigned NUM_CHUNKS = 6;
+
+std::vector<uint8_t> getChunkBytes(const unsigned index, const size_t size) {
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) bytes[i] = static_cast<uint8_t>((index * 31 + i) % 251);
+    return bytes;
+}
+
+bool writeChunk(chisel::RegionFile& region_file, std::vector<std::vector<uint8_t>>& chunks, const unsigned index, const size_t size) {
+    chunks[index] = getChunkBytes(index, size);
+
+    if (not region_file.write(index, chunks[index])) {
+        std::fprintf(stderr, "Chunk %u: write of %zu bytes failed\n", index, size);
+        return false;
+    }
+
+    return true;
+}
+
+bool checkFileSize(const std::filesystem::path& path, const size_t expected_size, const char* step) {
+    const size_t SIZE = std::filesystem::file_size(path);
+    if (SIZE == expected_size) return true;
+
+    std::fprintf(stderr, "%s: file of %zu bytes, expected %zu\n", step, SIZE, expected_size);
+    return false;
+}
+
+bool checkChunks(chisel::RegionFile& region_file, const std::vector<std::vector<uint8_t>>& chunks) {
+    for (unsigned index = 0; index < NUM_CHUNKS; index++) {
+        const uint8_t* bytes = nullptr;
+        size_t size = 0;
+        const bool IS_READ = region_file.read(index, bytes, size);
+
+        if (chunks[index].empty() ? IS_READ : not IS_READ or std::vector<uint8_t>(bytes, bytes + size) != chunks[index]) {
+            std::fprintf(stderr, "Chunk %u does not read back as written\n", index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    const std::filesystem::path PATH = std::filesystem::temp_directory_path() / "chisel_region_file_test.bin";
+    std::filesystem::remove(PATH);
+
+    std::vector<std::vector<uint8_t>> chunks(NUM_CHUNKS);
+    size_t file_size = 0;
+
+    {
+        chisel::RegionFile region_file { PATH };
+        if (not region_file.isValid()) return 1;
+
+        for (unsigned index = 0; index < 3; index++) {
+            if (not writeChunk(region_file, chunks, index, SECTOR_SIZE / 2)) return 1;
+        }
+
+        // Outgrows its sector and moves to the end, the sector it left takes the next chunk
+        if (not writeChunk(region_file, chunks, 0, 3 * SECTOR_SIZE)) return 1;
+        file_size = std::filesystem::file_size(PATH);
+        if (not writeChunk(region_file, chunks, 3, SECTOR_SIZE / 2)) return 1;
+        if (not checkFileSize(PATH, file_size, "Sector left by a moved chunk")) return 1;
+
+        // Shrinks in place, the chunk growing next fits in the sectors it gave up
+        if (not writeChunk(region_file, chunks, 0, SECTOR_SIZE)) return 1;
+        if (not writeChunk(region_file, chunks, 1, 2 * SECTOR_SIZE)) return 1;
+        if (not checkFileSize(PATH, file_size, "Sectors left by a shrunk chunk")) return 1;
+
+        if (not checkChunks(region_file, chunks)) return 1;
+    }
+
+    {
+        chisel::RegionFile region_file { PATH };
+        if (not region_file.isValid() or not checkChunks(region_file, chunks)) return 1;
+
+        // The sector chunk 1 moved out of is only known to be free from the table
+        if (not writeChunk(region_file, chunks, 4, SECTOR_SIZE)) return 1;
+        if (not checkFileSize(PATH, file_size, "Sector freed before reopening")) return 1;
+
+        if (not writeChunk(region_file, chunks, 5, 2 * SECTOR_SIZE)) return 1;
+        if (not checkFileSize(PATH, file_size + 2 * SECTOR_SIZE, "No free sectors left")) return 1;
+
+        if (not checkChunks(region_file, chunks)) return 1;
+    }
+
+    std::filesystem::remove(PATH);
+
+    std::printf("Freed sectors of %u chunks reused\n", NUM_CHUNKS);
+    return 0;
+}